@@ -0,0 +1,203 @@
+;
+;       CTextMovingMap - blit.s
+;       =======================
+;
+;       Option BLIT_ASM (compilation OSDK uniquement): version assembleur 6502 de l'affichage d'une
+;       ligne de la fenêtre (blit_map_row()) et du test des 4 déplacements possibles (map_walk_dirs()),
+;       avec des pointeurs en page zéro et l'adressage indirect indexé (ptr),y
+;
+;       Appel depuis le C (convention lcc/OSDK): paramètres sur la pile C, 2 octets chacun, lus par
+;       (sp),y; valeur de retour dans X (octet faible) et A (octet fort)
+;
+;       ATTENTION: constantes à garder identiques à movingmap.h (vérifié par render.c à la compilation)
+;
+
+WIN_XSIZE     = 30      ; largeur de la fenêtre (paire)
+MAP_ROW_BYTES = 50      ; octets d'une ligne de la carte (MAP_XSIZE/2)
+
+WALK_LEFT     = 1       ; bits renvoyés par _asm_walk_dirs (voir movingmap.h)
+WALK_RIGHT    = 2
+WALK_UP       = 4
+WALK_DOWN     = 8
+
+        .zero
+
+blit_dst        .dsb 2  ; adresse écran (ou tampon) de destination
+blit_src        .dsb 2  ; octet courant de la carte
+
+        .text
+
+;
+; void asm_blit_row(char *addr, char *cell_addr, coord xv)
+; affichage à l'adresse addr des WIN_XSIZE cases de la carte à partir de l'octet cell_addr (qui
+; contient la case n° xv): même résultat que blit_map_row() en C
+;
+_asm_blit_row
+        ldy #0
+        lda (sp),y
+        sta blit_dst
+        iny
+        lda (sp),y
+        sta blit_dst+1
+        iny
+        lda (sp),y
+        sta blit_src
+        iny
+        lda (sp),y
+        sta blit_src+1
+        iny
+        lda (sp),y              ; xv (octet faible): seule la parité compte
+        and #1
+        beq blit_even
+
+        ; xv impair: 1ère case = quartet inférieur du 1er octet
+        ldx #0
+        lda (blit_src,x)
+        tax
+        lda _cell_char_odd,x
+        ldy #0
+        sta (blit_dst),y
+        iny
+        inc blit_src
+        bne blit_odd_pairs
+        inc blit_src+1
+blit_odd_pairs
+        ; (WIN_XSIZE-2)/2 paires, Y = index écran
+        ldx #0
+        lda (blit_src,x)
+        tax
+        lda _cell_char_even,x
+        sta (blit_dst),y
+        iny
+        lda _cell_char_odd,x
+        sta (blit_dst),y
+        iny
+        inc blit_src
+        bne blit_odd_next
+        inc blit_src+1
+blit_odd_next
+        cpy #WIN_XSIZE-1
+        bne blit_odd_pairs
+
+        ; dernière case = quartet supérieur de l'octet suivant
+        ldx #0
+        lda (blit_src,x)
+        tax
+        lda _cell_char_even,x
+        sta (blit_dst),y
+        rts
+
+blit_even
+        ; xv pair: WIN_XSIZE/2 paires, Y = index écran
+        ldy #0
+blit_even_pairs
+        ldx #0
+        lda (blit_src,x)
+        tax
+        lda _cell_char_even,x
+        sta (blit_dst),y
+        iny
+        lda _cell_char_odd,x
+        sta (blit_dst),y
+        iny
+        inc blit_src
+        bne blit_even_next
+        inc blit_src+1
+blit_even_next
+        cpy #WIN_XSIZE
+        bne blit_even_pairs
+        rts
+
+;
+; uchar asm_walk_dirs(char *cell_addr, coord x)
+; déplacements possibles (bits WALK_xxx: cellule voisine vide) depuis la cellule x, contenue dans
+; l'octet cell_addr de la carte. Les 4 voisines sont lues par (blit_src),y à partir de la ligne
+; du dessus: Y = MAP_ROW_BYTES => ligne de la cellule, Y = 2*MAP_ROW_BYTES => ligne du dessous.
+; La carte étant entourée de murs, la cellule n'est jamais sur un bord: les voisines sont dans la carte
+;
+_asm_walk_dirs
+        ldy #0
+        lda (sp),y
+        sec
+        sbc #MAP_ROW_BYTES
+        sta blit_src
+        iny
+        lda (sp),y
+        sbc #0
+        sta blit_src+1
+        iny
+        lda (sp),y              ; x (octet faible): parité
+        and #1
+        beq walk_even
+
+        ; x impair: cellule = quartet inférieur; gauche = quartet supérieur du même octet,
+        ; droite = quartet supérieur de l'octet suivant, haut / bas = quartets inférieurs
+        ldx #0
+        ldy #MAP_ROW_BYTES
+        lda (blit_src),y
+        and #$F0
+        bne walk_odd_right
+        ldx #WALK_LEFT
+walk_odd_right
+        iny
+        lda (blit_src),y
+        and #$F0
+        bne walk_odd_up
+        txa
+        ora #WALK_RIGHT
+        tax
+walk_odd_up
+        ldy #0
+        lda (blit_src),y
+        and #$0F
+        bne walk_odd_down
+        txa
+        ora #WALK_UP
+        tax
+walk_odd_down
+        ldy #2*MAP_ROW_BYTES
+        lda (blit_src),y
+        and #$0F
+        bne walk_done
+        txa
+        ora #WALK_DOWN
+        tax
+        lda #0
+        rts
+
+walk_even
+        ; x pair: cellule = quartet supérieur; gauche = quartet inférieur de l'octet précédent,
+        ; droite = quartet inférieur du même octet, haut / bas = quartets supérieurs
+        ldx #0
+        ldy #MAP_ROW_BYTES-1
+        lda (blit_src),y
+        and #$0F
+        bne walk_even_right
+        ldx #WALK_LEFT
+walk_even_right
+        iny
+        lda (blit_src),y
+        and #$0F
+        bne walk_even_up
+        txa
+        ora #WALK_RIGHT
+        tax
+walk_even_up
+        ldy #0
+        lda (blit_src),y
+        and #$F0
+        bne walk_even_down
+        txa
+        ora #WALK_UP
+        tax
+walk_even_down
+        ldy #2*MAP_ROW_BYTES
+        lda (blit_src),y
+        and #$F0
+        bne walk_done
+        txa
+        ora #WALK_DOWN
+        tax
+walk_done
+        lda #0
+        rts
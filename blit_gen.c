@@ -0,0 +1,614 @@
+/**
+ *      CTextMovingMap - blit_gen.c
+ *      ===========================
+ * 
+ *      GENERE par host/mkblit (make blit) pour une fenêtre de 30x15 cases: ne pas modifier.
+ *      Routines d'affichage de la carte entièrement déroulées (option BLIT_GEN, voir render.c)
+ */
+
+#include "movingmap.h"
+
+#ifdef BLIT_GEN
+
+#if WIN_XSIZE != 30 || WIN_YSIZE != 15
+#error "blit_gen.c ne correspond pas a la fenetre configuree: le regenerer (make blit)"
+#endif
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/** 
+ * blit_row_even(addr, cell_addr): affichage à l'adresse addr des WIN_XSIZE cases à partir
+ * de l'octet cell_addr (xv pair)
+ */
+void blit_row_even(char *addr, char *cell_addr) {
+    uchar c;
+
+    c = (uchar) cell_addr[0]; addr[0] = cell_char_even[c]; addr[1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; addr[2] = cell_char_even[c]; addr[3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; addr[4] = cell_char_even[c]; addr[5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; addr[6] = cell_char_even[c]; addr[7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; addr[8] = cell_char_even[c]; addr[9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; addr[10] = cell_char_even[c]; addr[11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; addr[12] = cell_char_even[c]; addr[13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; addr[14] = cell_char_even[c]; addr[15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; addr[16] = cell_char_even[c]; addr[17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; addr[18] = cell_char_even[c]; addr[19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; addr[20] = cell_char_even[c]; addr[21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; addr[22] = cell_char_even[c]; addr[23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; addr[24] = cell_char_even[c]; addr[25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; addr[26] = cell_char_even[c]; addr[27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; addr[28] = cell_char_even[c]; addr[29] = cell_char_odd[c];
+}
+
+/** 
+ * blit_row_odd(addr, cell_addr): affichage à l'adresse addr des WIN_XSIZE cases à partir
+ * de l'octet cell_addr (xv impair)
+ */
+void blit_row_odd(char *addr, char *cell_addr) {
+    uchar c;
+
+    addr[0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; addr[1] = cell_char_even[c]; addr[2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; addr[3] = cell_char_even[c]; addr[4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; addr[5] = cell_char_even[c]; addr[6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; addr[7] = cell_char_even[c]; addr[8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; addr[9] = cell_char_even[c]; addr[10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; addr[11] = cell_char_even[c]; addr[12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; addr[13] = cell_char_even[c]; addr[14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; addr[15] = cell_char_even[c]; addr[16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; addr[17] = cell_char_even[c]; addr[18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; addr[19] = cell_char_even[c]; addr[20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; addr[21] = cell_char_even[c]; addr[22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; addr[23] = cell_char_even[c]; addr[24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; addr[25] = cell_char_even[c]; addr[26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; addr[27] = cell_char_even[c]; addr[28] = cell_char_odd[c];
+    addr[29] = cell_char_even[(uchar) cell_addr[15]];
+}
+
+#ifdef MAP_DENSE
+
+/** 
+ * blit_window_even(cell_addr): affichage de toute la fenêtre à partir de l'octet cell_addr
+ * du coin supérieur gauche (xv pair)
+ */
+void blit_window_even(char *cell_addr) {
+    uchar c;
+
+    // ligne 0
+    c = (uchar) cell_addr[0]; WIN_ADDR[0*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[0*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[0*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[0*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[0*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[0*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[0*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[0*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[0*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[0*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[0*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[0*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[0*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[0*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[0*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 1
+    c = (uchar) cell_addr[0]; WIN_ADDR[1*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[1*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[1*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[1*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[1*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[1*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[1*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[1*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[1*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[1*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[1*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[1*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[1*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[1*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[1*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 2
+    c = (uchar) cell_addr[0]; WIN_ADDR[2*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[2*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[2*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[2*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[2*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[2*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[2*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[2*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[2*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[2*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[2*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[2*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[2*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[2*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[2*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 3
+    c = (uchar) cell_addr[0]; WIN_ADDR[3*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[3*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[3*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[3*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[3*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[3*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[3*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[3*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[3*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[3*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[3*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[3*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[3*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[3*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[3*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 4
+    c = (uchar) cell_addr[0]; WIN_ADDR[4*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[4*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[4*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[4*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[4*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[4*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[4*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[4*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[4*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[4*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[4*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[4*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[4*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[4*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[4*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 5
+    c = (uchar) cell_addr[0]; WIN_ADDR[5*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[5*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[5*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[5*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[5*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[5*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[5*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[5*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[5*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[5*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[5*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[5*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[5*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[5*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[5*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 6
+    c = (uchar) cell_addr[0]; WIN_ADDR[6*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[6*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[6*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[6*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[6*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[6*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[6*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[6*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[6*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[6*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[6*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[6*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[6*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[6*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[6*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 7
+    c = (uchar) cell_addr[0]; WIN_ADDR[7*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[7*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[7*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[7*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[7*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[7*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[7*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[7*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[7*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[7*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[7*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[7*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[7*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[7*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[7*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 8
+    c = (uchar) cell_addr[0]; WIN_ADDR[8*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[8*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[8*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[8*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[8*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[8*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[8*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[8*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[8*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[8*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[8*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[8*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[8*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[8*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[8*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 9
+    c = (uchar) cell_addr[0]; WIN_ADDR[9*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[9*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[9*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[9*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[9*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[9*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[9*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[9*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[9*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[9*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[9*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[9*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[9*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[9*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[9*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 10
+    c = (uchar) cell_addr[0]; WIN_ADDR[10*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[10*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[10*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[10*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[10*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[10*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[10*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[10*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[10*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[10*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[10*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[10*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[10*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[10*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[10*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 11
+    c = (uchar) cell_addr[0]; WIN_ADDR[11*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[11*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[11*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[11*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[11*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[11*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[11*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[11*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[11*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[11*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[11*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[11*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[11*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[11*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[11*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 12
+    c = (uchar) cell_addr[0]; WIN_ADDR[12*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[12*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[12*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[12*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[12*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[12*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[12*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[12*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[12*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[12*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[12*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[12*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[12*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[12*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[12*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 13
+    c = (uchar) cell_addr[0]; WIN_ADDR[13*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[13*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[13*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[13*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[13*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[13*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[13*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[13*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[13*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[13*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[13*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[13*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[13*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[13*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[13*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+29] = cell_char_odd[c];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 14
+    c = (uchar) cell_addr[0]; WIN_ADDR[14*SCREEN_WIDTH+0] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+1] = cell_char_odd[c];
+    c = (uchar) cell_addr[1]; WIN_ADDR[14*SCREEN_WIDTH+2] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+3] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[14*SCREEN_WIDTH+4] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+5] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[14*SCREEN_WIDTH+6] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+7] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[14*SCREEN_WIDTH+8] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+9] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[14*SCREEN_WIDTH+10] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+11] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[14*SCREEN_WIDTH+12] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+13] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[14*SCREEN_WIDTH+14] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+15] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[14*SCREEN_WIDTH+16] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+17] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[14*SCREEN_WIDTH+18] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+19] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[14*SCREEN_WIDTH+20] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+21] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[14*SCREEN_WIDTH+22] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+23] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[14*SCREEN_WIDTH+24] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+25] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[14*SCREEN_WIDTH+26] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+27] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[14*SCREEN_WIDTH+28] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+29] = cell_char_odd[c];
+}
+
+/** 
+ * blit_window_odd(cell_addr): affichage de toute la fenêtre à partir de l'octet cell_addr
+ * du coin supérieur gauche (xv impair)
+ */
+void blit_window_odd(char *cell_addr) {
+    uchar c;
+
+    // ligne 0
+    WIN_ADDR[0*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[0*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[0*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[0*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[0*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[0*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[0*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[0*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[0*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[0*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[0*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[0*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[0*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[0*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[0*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[0*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[0*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 1
+    WIN_ADDR[1*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[1*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[1*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[1*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[1*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[1*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[1*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[1*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[1*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[1*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[1*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[1*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[1*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[1*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[1*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[1*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[1*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 2
+    WIN_ADDR[2*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[2*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[2*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[2*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[2*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[2*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[2*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[2*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[2*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[2*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[2*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[2*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[2*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[2*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[2*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[2*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[2*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 3
+    WIN_ADDR[3*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[3*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[3*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[3*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[3*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[3*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[3*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[3*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[3*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[3*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[3*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[3*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[3*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[3*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[3*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[3*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[3*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 4
+    WIN_ADDR[4*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[4*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[4*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[4*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[4*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[4*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[4*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[4*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[4*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[4*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[4*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[4*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[4*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[4*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[4*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[4*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[4*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 5
+    WIN_ADDR[5*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[5*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[5*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[5*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[5*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[5*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[5*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[5*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[5*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[5*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[5*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[5*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[5*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[5*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[5*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[5*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[5*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 6
+    WIN_ADDR[6*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[6*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[6*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[6*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[6*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[6*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[6*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[6*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[6*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[6*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[6*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[6*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[6*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[6*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[6*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[6*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[6*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 7
+    WIN_ADDR[7*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[7*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[7*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[7*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[7*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[7*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[7*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[7*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[7*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[7*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[7*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[7*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[7*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[7*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[7*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[7*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[7*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 8
+    WIN_ADDR[8*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[8*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[8*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[8*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[8*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[8*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[8*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[8*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[8*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[8*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[8*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[8*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[8*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[8*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[8*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[8*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[8*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 9
+    WIN_ADDR[9*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[9*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[9*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[9*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[9*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[9*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[9*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[9*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[9*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[9*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[9*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[9*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[9*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[9*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[9*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[9*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[9*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 10
+    WIN_ADDR[10*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[10*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[10*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[10*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[10*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[10*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[10*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[10*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[10*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[10*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[10*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[10*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[10*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[10*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[10*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[10*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[10*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 11
+    WIN_ADDR[11*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[11*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[11*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[11*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[11*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[11*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[11*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[11*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[11*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[11*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[11*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[11*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[11*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[11*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[11*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[11*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[11*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 12
+    WIN_ADDR[12*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[12*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[12*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[12*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[12*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[12*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[12*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[12*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[12*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[12*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[12*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[12*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[12*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[12*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[12*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[12*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[12*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 13
+    WIN_ADDR[13*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[13*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[13*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[13*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[13*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[13*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[13*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[13*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[13*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[13*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[13*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[13*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[13*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[13*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[13*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[13*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[13*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+    cell_addr += MAP_XSIZE/2;
+    // ligne 14
+    WIN_ADDR[14*SCREEN_WIDTH+0] = cell_char_odd[(uchar) cell_addr[0]];
+    c = (uchar) cell_addr[1]; WIN_ADDR[14*SCREEN_WIDTH+1] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+2] = cell_char_odd[c];
+    c = (uchar) cell_addr[2]; WIN_ADDR[14*SCREEN_WIDTH+3] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+4] = cell_char_odd[c];
+    c = (uchar) cell_addr[3]; WIN_ADDR[14*SCREEN_WIDTH+5] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+6] = cell_char_odd[c];
+    c = (uchar) cell_addr[4]; WIN_ADDR[14*SCREEN_WIDTH+7] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+8] = cell_char_odd[c];
+    c = (uchar) cell_addr[5]; WIN_ADDR[14*SCREEN_WIDTH+9] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+10] = cell_char_odd[c];
+    c = (uchar) cell_addr[6]; WIN_ADDR[14*SCREEN_WIDTH+11] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+12] = cell_char_odd[c];
+    c = (uchar) cell_addr[7]; WIN_ADDR[14*SCREEN_WIDTH+13] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+14] = cell_char_odd[c];
+    c = (uchar) cell_addr[8]; WIN_ADDR[14*SCREEN_WIDTH+15] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+16] = cell_char_odd[c];
+    c = (uchar) cell_addr[9]; WIN_ADDR[14*SCREEN_WIDTH+17] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+18] = cell_char_odd[c];
+    c = (uchar) cell_addr[10]; WIN_ADDR[14*SCREEN_WIDTH+19] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+20] = cell_char_odd[c];
+    c = (uchar) cell_addr[11]; WIN_ADDR[14*SCREEN_WIDTH+21] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+22] = cell_char_odd[c];
+    c = (uchar) cell_addr[12]; WIN_ADDR[14*SCREEN_WIDTH+23] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+24] = cell_char_odd[c];
+    c = (uchar) cell_addr[13]; WIN_ADDR[14*SCREEN_WIDTH+25] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+26] = cell_char_odd[c];
+    c = (uchar) cell_addr[14]; WIN_ADDR[14*SCREEN_WIDTH+27] = cell_char_even[c]; WIN_ADDR[14*SCREEN_WIDTH+28] = cell_char_odd[c];
+    WIN_ADDR[14*SCREEN_WIDTH+29] = cell_char_even[(uchar) cell_addr[15]];
+}
+
+#endif /* MAP_DENSE */
+
+#endif /* BLIT_GEN */
@@ -0,0 +1,310 @@
+/**
+ *      CTextMovingMap - entity.c
+ *      =========================
+ *
+ *      Entités (option ENTITIES): personnages non joueurs, jusqu'à ENT_MAX, rangés "par colonnes"
+ *      (un tableau par attribut: position, caractère, comportement...) et indexés par bandes de
+ *      ENT_BUCKET_ROWS lignes de la carte (une liste chaînée par bande): l'affichage ne parcourt
+ *      que les entités des bandes visibles.
+ *
+ *      Affichage incrémental (appelé par render_viewports()):
+ *      - une entité qui se déplace (entity_move()) est notée dans la liste des entités déplacées,
+ *        avec sa position précédente: seules ses 2 cases (ancienne et nouvelle) sont redessinées
+ *      - les autres entités ne sont redessinées que dans la partie de la fenêtre décodée à la passe
+ *        en cours (toute la fenêtre, ou la ligne / colonne découverte par un défilement)
+ *      Le coût d'une frame dépend donc du nombre d'entités qui bougent, pas du nombre affiché.
+ *      Deux entités n'occupent jamais la même case. Avec FOG, une entité hors du champ de vision
+ *      n'est pas affichée (voir ent_char()).
+ */
+
+#include "movingmap.h"
+
+#ifdef ENTITIES
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// attributs des entités 0 à ent_count-1
+coord ent_x[ENT_MAX], ent_y[ENT_MAX];
+char  ent_glyph[ENT_MAX];
+uchar ent_behaviour[ENT_MAX];
+uchar ent_count = 0;
+
+// état propre au comportement (ENT_PATROL: 1 = vers la droite)
+static uchar ent_state[ENT_MAX];
+
+// entité suivante de la même bande de lignes (ENT_NONE: fin de liste), 1ère entité de chaque bande
+static uchar ent_next[ENT_MAX];
+static uchar ent_bucket[ENT_BUCKETS];
+
+// entités déplacées depuis la dernière passe d'affichage, et leur position à cette passe
+static uchar ent_moved[ENT_MAX];
+static uchar ent_nb_moved = 0;
+static bool  ent_is_moved[ENT_MAX];
+static coord ent_old_x[ENT_MAX], ent_old_y[ENT_MAX];
+
+// déplacements d'un pas (gauche, droite, haut, bas)
+static signed char ent_dx[4] = { -1, 1, 0, 0 };
+static signed char ent_dy[4] = { 0, 0, -1, 1 };
+
+
+/* ================== MACROS ================== */
+
+// caractère affiché pour l'entité e: le sien, ou avec FOG la case de la carte (ou C_FOG) si
+// l'entité est hors du champ de vision
+#ifdef FOG
+#define ent_char(e) (fov_visible(ent_y[e], ent_x[e]) ? ent_glyph[e] : map_cell_char_shown(ent_y[e], ent_x[e]))
+#else
+#define ent_char(e) ent_glyph[e]
+#endif
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/**
+ * bucket_link(e) / bucket_unlink(e): ajout / retrait de l'entité e dans la liste de sa bande
+ */
+static void bucket_link(uchar e) {
+    uchar b = ent_y[e] >> ENT_BUCKET_SHIFT;
+
+    ent_next[e] = ent_bucket[b];
+    ent_bucket[b] = e;
+}
+
+static void bucket_unlink(uchar e) {
+    uchar *link = &ent_bucket[ent_y[e] >> ENT_BUCKET_SHIFT];
+
+    while(*link != e) link = &ent_next[*link];
+    *link = ent_next[e];
+}
+
+/**
+ * mark_moved(e): l'entité e est à redessiner à la prochaine passe (position actuelle = ancienne
+ * position affichée, sauf si elle a déjà été déplacée depuis la dernière passe)
+ */
+static void mark_moved(uchar e) {
+    if(ent_is_moved[e]) return;
+    ent_is_moved[e] = TRUE;
+    ent_old_x[e] = ent_x[e];
+    ent_old_y[e] = ent_y[e];
+    ent_moved[ent_nb_moved++] = e;
+}
+
+/**
+ * entity_add(y, x, glyph, behaviour): nouvelle entité sur la case (y, x); renvoie son n°, ou
+ * ENT_NONE si toutes sont utilisées ou si la case est déjà occupée
+ */
+uchar entity_add(coord y, coord x, char glyph, uchar behaviour) {
+    uchar e = ent_count;
+
+    if(e == ENT_MAX || entity_at(y, x) != ENT_NONE) return ENT_NONE;
+    ent_count++;
+    ent_x[e] = x;
+    ent_y[e] = y;
+    ent_glyph[e] = glyph;
+    ent_behaviour[e] = behaviour;
+    ent_state[e] = 0;
+    ent_is_moved[e] = FALSE;
+    bucket_link(e);
+    mark_moved(e);
+    return e;
+}
+
+/**
+ * entities_init(y, x): ENT_MAX entités placées au hasard sur des cases praticables libres d'un
+ * carré de ENT_SPREAD cases centré sur (y, x) (sauf (y, x)): 1 gardien pour 3 promeneurs
+ */
+void entities_init(coord y, coord x) {
+    uchar k, tries;
+    coord ky, kx;
+    uchar *b = ent_bucket;
+
+    for(k = 0; k < ENT_BUCKETS; k++) {
+        *b++ = ENT_NONE;
+    }
+    ent_count = 0;
+    ent_nb_moved = 0;
+
+    for(k = 0, tries = 0; k < ENT_MAX && tries < 255; tries++) {
+        ky = y + rnd(ENT_SPREAD) - ENT_SPREAD/2;
+        kx = x + rnd(ENT_SPREAD) - ENT_SPREAD/2;
+        if(ky < 1 || ky > MAP_YSIZE-2 || kx < 1 || kx > MAP_XSIZE-2) continue;
+        if((ky == y && kx == x) || !map_walkable(ky, kx)) continue;
+        if((k & 3) == 0) {
+            if(entity_add(ky, kx, C_GUARD, ENT_PATROL) == ENT_NONE) continue;
+        }
+        else {
+            if(entity_add(ky, kx, C_WANDERER, ENT_WANDER) == ENT_NONE) continue;
+        }
+        k++;
+    }
+}
+
+/**
+ * entity_move(e, y, x): déplacement de l'entité e sur la case (y, x) (changement de bande si besoin)
+ */
+void entity_move(uchar e, coord y, coord x) {
+    mark_moved(e);
+    if((y >> ENT_BUCKET_SHIFT) != (ent_y[e] >> ENT_BUCKET_SHIFT)) {
+        bucket_unlink(e);
+        ent_y[e] = y;
+        bucket_link(e);
+    }
+    ent_y[e] = y;
+    ent_x[e] = x;
+}
+
+/**
+ * entity_at(y, x): n° de l'entité sur la case (y, x), ENT_NONE si aucune
+ * (seule la bande de la ligne y est parcourue)
+ */
+uchar entity_at(coord y, coord x) {
+    uchar e = ent_bucket[y >> ENT_BUCKET_SHIFT];
+
+    while(e != ENT_NONE && (ent_y[e] != y || ent_x[e] != x)) e = ent_next[e];
+    return e;
+}
+
+/**
+ * entity_cell_char(y, x): caractère de la case (y, x) sans le joueur: entité, sinon carte
+ */
+char entity_cell_char(coord y, coord x) {
+    uchar e = entity_at(y, x);
+
+    return (e != ENT_NONE) ? ent_char(e) : map_cell_char_shown(y, x);
+}
+
+/**
+ * entity_can_enter(y, x): case (y, x) dans la carte, praticable et libre
+ */
+static bool entity_can_enter(coord y, coord x) {
+    return y < MAP_YSIZE && x < MAP_XSIZE && map_walkable(y, x) && entity_at(y, x) == ENT_NONE;
+}
+
+/**
+ * entities_update(): un pas de comportement de chaque entité
+ * - ENT_WANDER: une chance sur 2 de faire un pas dans une direction au hasard
+ * - ENT_PATROL: un pas à droite ou à gauche, demi-tour devant un obstacle
+ */
+void entities_update() {
+    uchar e, r;
+    coord y, x;
+
+    for(e = 0; e < ent_count; e++) {
+        y = ent_y[e];
+        x = ent_x[e];
+        switch(ent_behaviour[e]) {
+            case ENT_WANDER:
+                r = rnd(8);
+                if(r >= 4) break;
+                y += ent_dy[r];
+                x += ent_dx[r];
+                if(entity_can_enter(y, x)) entity_move(e, y, x);
+                break;
+            case ENT_PATROL:
+                x += ent_state[e] ? 1 : -1;
+                if(entity_can_enter(y, x)) entity_move(e, y, x);
+                else ent_state[e] ^= 1;
+                break;
+        }
+    }
+}
+
+/**
+ * in_view(vp, y, x): la case (y, x) est visible dans la fenêtre vp
+ */
+#define in_view(vp, y, x) ((y) >= (vp)->yv && (y) < (vp)->yv + (vp)->ysize  \
+                        && (x) >= (vp)->xv && (x) < (vp)->xv + (vp)->xsize)
+
+#define view_addr(vp, y, x) ((vp)->addr + ((y) - (vp)->yv)*SCREEN_WIDTH + ((x) - (vp)->xv))
+
+/**
+ * entities_erase_moved(vp): avant le défilement de la fenêtre vp, effacement des entités
+ * déplacées à leur position de la passe précédente (case de la carte, ou autre entité)
+ */
+void entities_erase_moved(viewport *vp) {
+    uchar k, e;
+
+    for(k = 0; k < ent_nb_moved; k++) {
+        e = ent_moved[k];
+        if(in_view(vp, ent_old_y[e], ent_old_x[e])) {
+            *view_addr(vp, ent_old_y[e], ent_old_x[e]) = entity_cell_char(ent_old_y[e], ent_old_x[e]);
+            count_writes(1);
+        }
+    }
+}
+
+/**
+ * overlay_rows(vp, y0, y1, x0, x1): affichage des entités des lignes y0 à y1-1 et des colonnes
+ * x0 à x1-1 (visibles dans vp), en ne parcourant que les bandes de ces lignes
+ */
+static void overlay_rows(viewport *vp, coord y0, coord y1, coord x0, coord x1) {
+    uchar b, e;
+    uchar b1 = (y1-1) >> ENT_BUCKET_SHIFT;
+
+    for(b = y0 >> ENT_BUCKET_SHIFT; b <= b1; b++) {
+        for(e = ent_bucket[b]; e != ENT_NONE; e = ent_next[e]) {
+            if(ent_y[e] >= y0 && ent_y[e] < y1 && ent_x[e] >= x0 && ent_x[e] < x1) {
+                *view_addr(vp, ent_y[e], ent_x[e]) = ent_char(e);
+                count_writes(1);
+            }
+        }
+    }
+}
+
+/**
+ * entities_overlay(vp): après la mise à jour de la carte dans la fenêtre vp, affichage des entités
+ * dans la partie décodée à cette passe, puis des entités déplacées à leur nouvelle position
+ */
+void entities_overlay(viewport *vp) {
+    uchar k, e;
+    coord yv = vp->yv, xv = vp->xv;
+
+    switch(vp->exposed) {
+        case VIEW_EXPOSED_FULL:
+            overlay_rows(vp, yv, yv + vp->ysize, xv, xv + vp->xsize);
+            break;
+        case VIEW_EXPOSED_ROW:
+            overlay_rows(vp, yv + vp->exposed_at, yv + vp->exposed_at + 1, xv, xv + vp->xsize);
+            break;
+        case VIEW_EXPOSED_COLUMN:
+            overlay_rows(vp, yv, yv + vp->ysize, xv + vp->exposed_at, xv + vp->exposed_at + 1);
+            break;
+    }
+
+    for(k = 0; k < ent_nb_moved; k++) {
+        e = ent_moved[k];
+        if(in_view(vp, ent_y[e], ent_x[e])) {
+            *view_addr(vp, ent_y[e], ent_x[e]) = ent_char(e);
+            count_writes(1);
+        }
+    }
+}
+
+#ifdef FOG
+/**
+ * entities_redraw_area(vp, y0, y1, x0, x1): réaffichage des entités des lignes y0 à y1-1 et des
+ * colonnes x0 à x1-1 visibles dans vp (champ de vision modifié, voir fov_redraw())
+ */
+void entities_redraw_area(viewport *vp, coord y0, coord y1, coord x0, coord x1) {
+    if(y0 < vp->yv) y0 = vp->yv;
+    if(y1 > vp->yv + vp->ysize) y1 = vp->yv + vp->ysize;
+    if(x0 < vp->xv) x0 = vp->xv;
+    if(x1 > vp->xv + vp->xsize) x1 = vp->xv + vp->xsize;
+    if(y0 < y1 && x0 < x1) overlay_rows(vp, y0, y1, x0, x1);
+}
+#endif
+
+/**
+ * entities_moved_clear(): fin de la passe d'affichage: plus aucune entité à redessiner
+ */
+void entities_moved_clear() {
+    uchar k;
+
+    for(k = 0; k < ent_nb_moved; k++) {
+        ent_is_moved[ent_moved[k]] = FALSE;
+    }
+    ent_nb_moved = 0;
+}
+
+#endif /* ENTITIES */
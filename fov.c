@@ -0,0 +1,297 @@
+/**
+ *      CTextMovingMap - fov.c
+ *      ======================
+ *
+ *      Brouillard de guerre (option FOG): champ de vision du personnage et plan des cases déjà vues.
+ *
+ *      Champ de vision: cases à moins de FOV_RADIUS (disque) reliées au personnage par une ligne de
+ *      visée qui ne traverse pas de terrain opaque (is_opaque(), les cases opaques elles-mêmes sont
+ *      vues). Les lignes de visée sont précalculées par fov_init() pour un octant: chaque case (a, b)
+ *      (a = distance sur l'axe principal, 0 <= b <= a) a pour "parent" la case de la distance a-1
+ *      la plus proche du segment qui la relie au personnage. Une case est vue si son parent est vu
+ *      et transparent: un seul test par case et par octant, dans l'ordre des distances croissantes,
+ *      sans récursion ni division (le 6502 n'en a pas).
+ *
+ *      Le champ de vision est gardé (bits vus / transparents d'un carré de FOV_SIZE cases) et n'est
+ *      recalculé que si le personnage s'est déplacé ou si la carte a changé (fov_invalidate()).
+ *      Les cases vues pour la 1ère fois sont notées (fov_fresh[]) pour n'être redessinées qu'elles.
+ *      Quand plusieurs déplacements sont appliqués avant un seul affichage (voir play_map()), les
+ *      cases vues depuis les positions intermédiaires sont aussi explorées (fov_explore()): le plan
+ *      exploré ne dépend pas du rythme des frames.
+ *      Le décodage des lignes et colonnes de la carte teste le plan "exploré" au même passage
+ *      (fov_blit_row(), draw_map_column()).
+ */
+
+#include "movingmap.h"
+
+#ifdef FOG
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// plan des cases déjà vues: même format que le plan de praticabilité (voir walk_plane[])
+uchar fov_explored[MAP_YSIZE][WALK_PLANE_BYTES];
+
+// carré du champ de vision centré sur (fov_y, fov_x): cases vues, cases vues et transparentes,
+// cases vues pour la 1ère fois au dernier calcul
+uchar fov_vis[FOV_SIZE][FOV_BYTES];
+static uchar fov_pass[FOV_SIZE][FOV_BYTES];
+static uchar fov_fresh[FOV_SIZE][FOV_BYTES];
+coord fov_y, fov_x;
+
+// centre du champ de vision à la passe d'affichage précédente; champ de vision à jour,
+// champ de vision modifié depuis la passe d'affichage précédente
+static coord fov_old_y, fov_old_x;
+static bool  fov_started = FALSE;
+static bool  fov_valid = FALSE;
+static bool  fov_changed = FALSE;
+
+// cases explorées depuis une position intermédiaire (fov_explore()) depuis la passe d'affichage
+// précédente, et rectangle qui les contient (lignes y0 à y1, colonnes x0 à x1 incluses)
+static bool  fov_extra = FALSE;
+static coord fov_ey0, fov_ey1, fov_ex0, fov_ex1;
+
+// cases d'un octant par distance croissante: (a, b) et b du parent (distance a-1)
+static uchar fov_a[FOV_CELLS_MAX], fov_b[FOV_CELLS_MAX], fov_pb[FOV_CELLS_MAX];
+static uchar fov_nb_cells;
+
+
+/* ================== MACROS ================== */
+
+// bit de la case (i, j) d'un carré FOV_SIZE x FOV_SIZE
+#define fov_test(plane, i, j) ((plane)[i][(j) >> 3] & walk_bit[(j) & 7])
+#define fov_set(plane, i, j)  ((plane)[i][(j) >> 3] |= walk_bit[(j) & 7])
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/**
+ * fov_init(): table des lignes de visée d'un octant, aucune case vue
+ */
+void fov_init() {
+    uchar a, b, i, j;
+    uchar *e = &fov_explored[0][0];
+    unsigned int k;
+
+    fov_nb_cells = 0;
+    for(a = 1; a <= FOV_RADIUS; a++) {
+        for(b = 0; b <= a; b++) {
+            if(a*a + b*b > FOV_RADIUS*FOV_RADIUS + FOV_RADIUS) break;
+            fov_a[fov_nb_cells] = a;
+            fov_b[fov_nb_cells] = b;
+            // b*(a-1)/a arrondi
+            fov_pb[fov_nb_cells] = (2*b*(a-1) + a) / (2*a);
+            fov_nb_cells++;
+        }
+    }
+
+    for(k = 0; k < MAP_YSIZE*WALK_PLANE_BYTES; k++) {
+        *e++ = 0;
+    }
+    for(i = 0; i < FOV_SIZE; i++) {
+        for(j = 0; j < FOV_BYTES; j++) {
+            fov_vis[i][j] = 0;
+        }
+    }
+    fov_started = FALSE;
+    fov_valid = FALSE;
+    fov_changed = FALSE;
+    fov_extra = FALSE;
+}
+
+/**
+ * fov_invalidate(): la carte a changé, le champ de vision sera recalculé au prochain fov_update()
+ */
+void fov_invalidate() {
+    fov_valid = FALSE;
+}
+
+/**
+ * fov_see(i, j, y, x, current): la case (i, j) du carré, case (y, x) de la carte, est vue: elle
+ * devient explorée si elle ne l'était pas. Champ de vision actuel (current): elle est notée vue
+ * (et à redessiner si elle est nouvelle), sinon seul le rectangle des cases à redessiner est agrandi
+ */
+static void fov_see(uchar i, uchar j, coord y, coord x, bool current) {
+    if(current) fov_set(fov_vis, i, j);
+    if(!is_opaque(get_map_cell_value(y, x))) fov_set(fov_pass, i, j);
+    if(!fov_explored_test(y, x)) {
+        fov_explored[y][x >> 3] |= walk_bit[x & 7];
+        if(current) {
+            fov_set(fov_fresh, i, j);
+        }
+        else if(!fov_extra) {
+            fov_extra = TRUE;
+            fov_ey0 = fov_ey1 = y;
+            fov_ex0 = fov_ex1 = x;
+        }
+        else {
+            if(y < fov_ey0) fov_ey0 = y;
+            if(y > fov_ey1) fov_ey1 = y;
+            if(x < fov_ex0) fov_ex0 = x;
+            if(x > fov_ex1) fov_ex1 = x;
+        }
+    }
+}
+
+/**
+ * fov_cast(y, x, current): lignes de visée depuis (y, x), dans l'ordre des distances croissantes
+ * (voir fov_see())
+ */
+static void fov_cast(coord y, coord x, bool current) {
+    uchar k, o, i, j;
+    uchar a, b, pa, pb;
+    signed char dy, dx, py, px;
+    coord cy, cx;
+
+    for(i = 0; i < FOV_SIZE; i++) {
+        for(j = 0; j < FOV_BYTES; j++) {
+            if(current) fov_vis[i][j] = 0;
+            fov_pass[i][j] = 0;
+        }
+    }
+
+    // la case du personnage est toujours vue et laisse passer la vue
+    fov_see(FOV_RADIUS, FOV_RADIUS, y, x, current);
+    fov_set(fov_pass, FOV_RADIUS, FOV_RADIUS);
+
+    for(k = 0; k < fov_nb_cells; k++) {
+        a = fov_a[k]; b = fov_b[k];
+        pa = a-1; pb = fov_pb[k];
+        // octant o: bit 2 = axes échangés, bit 1 = x négatif, bit 0 = y négatif
+        for(o = 0; o < 8; o++) {
+            if(o & 4) { dy = b; dx = a; py = pb; px = pa; }
+            else      { dy = a; dx = b; py = pa; px = pb; }
+            if(o & 1) { dy = -dy; py = -py; }
+            if(o & 2) { dx = -dx; px = -px; }
+            if(!fov_test(fov_pass, FOV_RADIUS + py, FOV_RADIUS + px)) continue;
+            // hors de la carte: coordonnée "négative" = valeur > 255 - FOV_RADIUS
+            cy = y + dy; cx = x + dx;
+            if(cy >= MAP_YSIZE || cx >= MAP_XSIZE) continue;
+            fov_see(FOV_RADIUS + dy, FOV_RADIUS + dx, cy, cx, current);
+        }
+    }
+}
+
+/**
+ * fov_update(y, x): champ de vision du personnage en (y, x) (rien à faire s'il n'a pas bougé);
+ * appelé une fois par frame, avant render_viewports()
+ */
+void fov_update(coord y, coord x) {
+    uchar i, j;
+
+    if(fov_valid && y == fov_y && x == fov_x) return;
+    if(!fov_changed) {
+        // 1er calcul depuis la dernière passe d'affichage: les cases redessinées seront celles
+        // des champs de vision de cette passe et de la suivante
+        fov_old_y = fov_started ? fov_y : y;
+        fov_old_x = fov_started ? fov_x : x;
+        for(i = 0; i < FOV_SIZE; i++) {
+            for(j = 0; j < FOV_BYTES; j++) {
+                fov_fresh[i][j] = 0;
+            }
+        }
+    }
+    fov_y = y;
+    fov_x = x;
+    fov_started = TRUE;
+    fov_valid = TRUE;
+    fov_changed = TRUE;
+    fov_cast(y, x, TRUE);
+}
+
+/**
+ * fov_explore(y, x): position intermédiaire du personnage entre 2 affichages: les cases vues depuis
+ * (y, x) deviennent explorées (elles seront redessinées par fov_redraw()), le champ de vision
+ * actuel (fov_vis[]) est inchangé
+ */
+void fov_explore(coord y, coord x) {
+    fov_cast(y, x, FALSE);
+    fov_valid = FALSE;
+}
+
+/**
+ * fov_blit_row(addr, y, xv, n): affichage à l'adresse addr des n cases de la ligne y de la carte à
+ * partir de la case xv, en un seul passage sur les octets de la carte et du plan exploré
+ */
+void fov_blit_row(char *addr, coord y, coord xv, uchar n) {
+    char *cell_addr = &map[y][div2(xv)];
+    uchar *seen = &fov_explored[y][xv >> 3];
+    uchar bits = *seen;
+    uchar mask = walk_bit[xv & 7];
+    bool odd = is_odd(xv);
+
+    count_writes(n);
+    for(; n > 0; n--) {
+        if(mask == 0) {
+            mask = 0x80;
+            bits = *++seen;
+        }
+        if(!(bits & mask))  *addr = C_FOG;
+        else if(odd)        *addr = cell_char_odd[(uchar) *cell_addr];
+        else                *addr = cell_char_even[(uchar) *cell_addr];
+        addr++;
+        if(odd) cell_addr++;
+        odd = !odd;
+        mask >>= 1;
+    }
+}
+
+/**
+ * fov_redraw(vp): après la mise à jour de la carte dans la fenêtre vp, affichage des cases vues
+ * pour la 1ère fois (champ de vision actuel et positions intermédiaires), et des entités qui ont
+ * pu entrer ou sortir du champ de vision (celles des carrés des champs de vision précédent et
+ * actuel)
+ */
+void fov_redraw(viewport *vp) {
+    uchar i, j;
+    coord y, x;
+#ifdef ENTITIES
+    coord y0, y1, x0, x1;
+#endif
+
+    if(fov_extra) {
+        // cases explorées depuis les positions intermédiaires
+        for(y = fov_ey0; y <= fov_ey1; y++) {
+            if(y < vp->yv || y >= vp->yv + vp->ysize) continue;
+            for(x = fov_ex0; x <= fov_ex1; x++) {
+                if(x < vp->xv || x >= vp->xv + vp->xsize) continue;
+                vp->addr[(y - vp->yv)*SCREEN_WIDTH + (x - vp->xv)] = cell_char_under(y, x);
+                count_writes(1);
+            }
+        }
+    }
+    if(!fov_changed) return;
+    for(i = 0; i < FOV_SIZE; i++) {
+        y = fov_y - FOV_RADIUS + i;
+        if(y < vp->yv || y >= vp->yv + vp->ysize) continue;
+        for(j = 0; j < FOV_SIZE; j++) {
+            if(!fov_test(fov_fresh, i, j)) continue;
+            x = fov_x - FOV_RADIUS + j;
+            if(x < vp->xv || x >= vp->xv + vp->xsize) continue;
+            vp->addr[(y - vp->yv)*SCREEN_WIDTH + (x - vp->xv)] = cell_char_under(y, x);
+            count_writes(1);
+        }
+    }
+
+#ifdef ENTITIES
+    y0 = (fov_old_y < fov_y) ? fov_old_y : fov_y;
+    y1 = (fov_old_y < fov_y) ? fov_y : fov_old_y;
+    x0 = (fov_old_x < fov_x) ? fov_old_x : fov_x;
+    x1 = (fov_old_x < fov_x) ? fov_x : fov_old_x;
+    y0 = (y0 < FOV_RADIUS) ? 0 : y0 - FOV_RADIUS;
+    x0 = (x0 < FOV_RADIUS) ? 0 : x0 - FOV_RADIUS;
+    y1 = (y1 + FOV_RADIUS+1 > MAP_YSIZE) ? MAP_YSIZE : y1 + FOV_RADIUS+1;
+    x1 = (x1 + FOV_RADIUS+1 > MAP_XSIZE) ? MAP_XSIZE : x1 + FOV_RADIUS+1;
+    entities_redraw_area(vp, y0, y1, x0, x1);
+#endif
+}
+
+/**
+ * fov_changes_clear(): fin de la passe d'affichage: plus aucune case à redessiner
+ */
+void fov_changes_clear() {
+    fov_changed = FALSE;
+    fov_extra = FALSE;
+}
+
+#endif /* FOG */
@@ -0,0 +1,303 @@
+/**
+ *      CTextMovingMap - host/bench.c
+ *      =============================
+ * 
+ *      Banc de mesure du moteur de carte sur PC: génère la carte (graine -s), puis rejoue
+ *      dans play_map() une longue suite de déplacements "scriptés" (séries de pas dans une même
+ *      direction, pour provoquer des défilements), et mesure pour chaque frame:
+ *      - le temps écoulé entre 2 appuis de touche (affichage + gestion du déplacement); chaque pas
+ *        du script est un appui suivi d'un relâchement (un événement par pas, voir input.c)
+ *      - le nombre d'octets écrits dans l'écran TEXT (et le tampon de composition avec DOUBLE_BUFFER)
+ *        par les routines d'affichage (count_writes(), voir platform.h), et en second le nombre
+ *        d'octets de l'écran réellement modifiés par rapport à la frame précédente
+ *      - avec FRAME_STATS, la durée moyenne de chaque étape de la frame (voir stats.c)
+ * 
+ *      Usage: bench [-n nb_deplacements] [-s graine] [-w monde] [-m niveau] [-e nb_modifications] [-d]
+ *             -w: fichier du monde en mode MAP_TILED (par défaut BUILD/host/world.bin)
+ *             -m: avec MAP_FILE, niveau chargé à la place de la carte générée (ex. make level =>
+ *                 BUILD/host/level.map); sans -m, la carte générée est sauvegardée dans un fichier
+ *                 temporaire puis rechargée. Le temps de chargement est affiché à côté de celui de
+ *                 init_map()
+ *             -e: avant la partie, modifie des cellules au hasard (set_map_cell()) et vérifie le
+ *                 plan de praticabilité, la mini-carte (MINIMAP) et le champ de vision (FOG) tenus à
+ *                 jour à chaque modification (code de retour 1 en cas de différence)
+ *             -d: affiche le contenu de l'écran simulé à la fin
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "host_platform.h"
+
+
+/* ================== CONSTANTES ================== */
+
+// modifications de cellules de -e: demi-côté du carré autour du point de départ
+#define FOV_CHECK_RADIUS 8
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+static char prev_screen[SCREEN_WIDTH*SCREEN_HEIGHT];
+
+// script de touches et nombre de lectures du clavier déjà faites
+static uchar        *keys;
+static unsigned long nb_keys, nb_reads;
+
+static unsigned long      frames;
+static unsigned long long t_last, ns_total, ns_min, ns_max, ns_init;
+#ifdef MAP_FILE
+static unsigned long long ns_load;
+#endif
+static unsigned long long bytes_total;
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+static unsigned long long now_ns() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long) ts.tv_sec * 1000000000ULL + (unsigned long long) ts.tv_nsec;
+}
+
+/**
+ * on_key_read(): lecture d'un appui (fin d'une frame de play_map()) => comptabilisation du temps
+ * et des octets modifiés; les lectures d'un relâchement ne terminent pas de frame.
+ * Le temps passé ici (comparaison des écrans) est exclu de la mesure.
+ */
+static void on_key_read() {
+    unsigned long long dt;
+    int i;
+
+    if(nb_reads < nb_keys && keys[nb_reads++] == NO_KEY) return;
+    dt = now_ns() - t_last;
+    frames++;
+    ns_total += dt;
+    if(frames == 1 || dt < ns_min) ns_min = dt;
+    if(dt > ns_max) ns_max = dt;
+
+    for(i = 0; i < SCREEN_WIDTH*SCREEN_HEIGHT; i++) {
+        if(host_text_screen[i] != prev_screen[i]) bytes_total++;
+    }
+    memcpy(prev_screen, host_text_screen, sizeof(prev_screen));
+
+    t_last = now_ns();
+}
+
+#ifdef MAP_DENSE
+/**
+ * check_edits(count, seed): vérification de set_map_cell() sur count modifications de cellules au
+ * hasard (la moitié autour du point de départ): après chaque modification, avec FOG, le champ de
+ * vision doit être recalculé (comparé à un calcul forcé); à la fin, le plan de praticabilité et,
+ * avec MINIMAP, la mini-carte tenus à jour cellule par cellule doivent être identiques à ceux
+ * reconstruits entièrement. Renvoie le nombre de différences
+ */
+static unsigned long check_edits(unsigned long count, unsigned long seed) {
+    static uchar plane[MAP_YSIZE][WALK_PLANE_BYTES];
+    unsigned long k, errors = 0;
+    coord y, x;
+    uchar v;
+#ifdef MINIMAP
+    static char mini[MINIMAP_YSIZE][MINIMAP_XSIZE];
+    uchar i;
+#endif
+#ifdef FOG
+    static uchar vis[FOV_SIZE][FOV_BYTES];
+#endif
+
+#ifdef MAP_LAZY
+    map_prepare(0, 0, MAP_YSIZE, MAP_XSIZE);
+#endif
+#ifdef MINIMAP
+    minimap_draw();
+#endif
+#ifdef FOG
+    fov_init();
+    fov_update(map_start.y, map_start.x);
+#endif
+    for(k = 0; k < count; k++) {
+        seed = seed * 1103515245UL + 12345UL;
+        v = (uchar) ((seed >> 8) % (V_HILL2+1));
+        if(k & 1) {
+            y = (coord) (1 + (seed >> 12) % (MAP_YSIZE-2));
+            x = (coord) (1 + (seed >> 20) % (MAP_XSIZE-2));
+        }
+        else {
+            y = (coord) (map_start.y - FOV_CHECK_RADIUS + (seed >> 12) % (2*FOV_CHECK_RADIUS+1));
+            x = (coord) (map_start.x - FOV_CHECK_RADIUS + (seed >> 20) % (2*FOV_CHECK_RADIUS+1));
+        }
+        if(y == map_start.y && x == map_start.x) continue;
+        set_map_cell(y, x, v);
+#ifdef FOG
+        fov_update(map_start.y, map_start.x);
+        memcpy(vis, fov_vis, sizeof(vis));
+        fov_invalidate();
+        fov_update(map_start.y, map_start.x);
+        if(memcmp(vis, fov_vis, sizeof(vis)) != 0) {
+            if(errors++ == 0) fprintf(stderr, "set_map_cell(%u, %u): champ de vision pas recalcule\n", y, x);
+        }
+#endif
+    }
+
+    memcpy(plane, walk_plane, sizeof(plane));
+    walk_plane_update(0, 0, MAP_YSIZE, MAP_XSIZE);
+    if(memcmp(plane, walk_plane, sizeof(plane)) != 0) {
+        errors++;
+        fprintf(stderr, "set_map_cell: plan de praticabilite different du plan reconstruit\n");
+    }
+#ifdef MINIMAP
+    for(i = 0; i < MINIMAP_YSIZE; i++) memcpy(mini[i], MINIMAP_ADDR + i*SCREEN_WIDTH, MINIMAP_XSIZE);
+    minimap_build();
+    minimap_draw();
+    for(i = 0; i < MINIMAP_YSIZE; i++) {
+        if(memcmp(mini[i], MINIMAP_ADDR + i*SCREEN_WIDTH, MINIMAP_XSIZE) != 0) {
+            if(errors++ == 0) fprintf(stderr, "set_map_cell: mini-carte differente (ligne %u)\n", i);
+        }
+    }
+#endif
+    return errors;
+}
+#endif
+
+#ifdef MAP_FILE
+/**
+ * load_map(level, seed): chargement chronométré (ns_load) du niveau level, ou sans niveau de la
+ * carte générée, d'abord sauvegardée dans un fichier temporaire (supprimé ensuite: le niveau et
+ * la partie sauvegardée ne sont jamais écrasés); FALSE si la carte ne peut être chargée
+ */
+static bool load_map(const char *level, unsigned long seed) {
+    static char temp[] = "/tmp/bench_map_XXXXXX";
+    map_info info;
+    uchar file = STORE_DATA;
+    bool ok;
+    int fd;
+
+    if(level != NULL) host_store_file = level;
+    else {
+        fd = mkstemp(temp);
+        if(fd < 0) { perror(temp); return FALSE; }
+        close(fd);
+        host_save_file = temp;
+        info.seed = (unsigned int) seed;
+        info.start = map_start;
+        if(!map_file_save(&info)) { perror(temp); remove(temp); return FALSE; }
+        file = STORE_SAVE;
+    }
+    t_last = now_ns();
+    ok = map_file_load(file, &info);
+    ns_load = now_ns() - t_last;
+    if(level == NULL) remove(temp);
+    if(!ok) fprintf(stderr, "%s: carte illisible\n", level != NULL ? level : temp);
+    return ok;
+}
+#endif
+
+/**
+ * make_moves(): suite reproductible de déplacements, par séries de 1 à 8 pas dans une même direction
+ * (2*count touches: chaque pas est un appui suivi d'un relâchement)
+ */
+static uchar *make_moves(unsigned long count, unsigned long seed) {
+    static const uchar dirs[4] = { KEY_LEFT, KEY_RIGHT, KEY_UP, KEY_DOWN };
+    uchar *k = malloc(2*count);
+    unsigned long i = 0, run;
+    uchar key;
+
+    while(i < 2*count) {
+        seed = seed * 1103515245UL + 12345UL;
+        key = dirs[(seed >> 16) & 3];
+        run = 1 + ((seed >> 20) & 7);
+        for(; run > 0 && i < 2*count; run--) {
+            k[i++] = key;
+            k[i++] = NO_KEY;
+        }
+    }
+    return k;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned long moves = 10000, seed = 1, edits = 0;
+    const char *level = NULL;
+    bool dump = FALSE;
+    int i;
+
+    for(i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-n") == 0 && i+1 < argc) moves = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "-s") == 0 && i+1 < argc) seed = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "-w") == 0 && i+1 < argc) host_store_file = argv[++i];
+        else if(strcmp(argv[i], "-m") == 0 && i+1 < argc) level = argv[++i];
+        else if(strcmp(argv[i], "-e") == 0 && i+1 < argc) edits = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "-d") == 0) dump = TRUE;
+        else {
+            fprintf(stderr, "usage: %s [-n moves] [-s seed] [-w world] [-m level] [-e edits] [-d]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    rnd_seed((unsigned int) seed);
+    cls();
+    t_last = now_ns();
+    init_map();
+    ns_init = now_ns() - t_last;
+#ifdef MAP_FILE
+    if(!load_map(level, seed)) return 1;
+#else
+    if(level != NULL) {
+        fprintf(stderr, "-m: option MAP_FILE uniquement\n");
+        return 2;
+    }
+#endif
+#ifdef MINIMAP
+    minimap_build();
+#endif
+    if(edits > 0) {
+#ifdef MAP_DENSE
+        unsigned long errors = check_edits(edits, seed);
+
+        fprintf(stdout, "set_map_cell:       %lu modifications, %lu differences\n", edits, errors);
+        if(errors != 0) return 1;
+#else
+        fprintf(stderr, "-e: mode MAP_DENSE uniquement\n");
+        return 2;
+#endif
+    }
+    cls();
+    display_window();
+
+    keys = make_moves(moves, seed);
+    nb_keys = 2*moves;
+    host_set_keys(keys, nb_keys);
+    host_on_key_read = on_key_read;
+    memcpy(prev_screen, host_text_screen, sizeof(prev_screen));
+    host_bytes_written = 0;
+    t_last = now_ns();
+    play_map();
+    host_on_key_read = NULL;
+
+    if(dump) host_dump_screen(stdout);
+    fprintf(stdout, "moves:              %lu (seed %lu)\n", moves, seed);
+#ifdef MAP_FILE
+    fprintf(stdout, "init_map:           %llu ns  map_file_load %llu ns (%s)\n", ns_init, ns_load,
+            level != NULL ? level : "carte generee");
+#else
+    fprintf(stdout, "init_map:           %llu ns\n", ns_init);
+#endif
+    fprintf(stdout, "frames:             %lu\n", frames);
+    fprintf(stdout, "ns/frame:           avg %.0f  min %llu  max %llu\n",
+            (double) ns_total / frames, ns_min, ns_max);
+    fprintf(stdout, "bytes/frame:        %.1f written  (%.1f screen bytes changed)\n",
+            (double) host_bytes_written / frames, (double) bytes_total / frames);
+#ifdef FRAME_STATS
+    // NB: l'étape CLAV comprend aussi le temps de on_key_read() (comparaison des écrans)
+    fprintf(stdout, "us/frame par etape: clav %.2f  vues %.2f  carte %.2f  perso %.2f  infos %.2f\n",
+            (double) stats_total[STAGE_INPUT] / frames, (double) stats_total[STAGE_VIEW] / frames,
+            (double) stats_total[STAGE_BLIT] / frames, (double) stats_total[STAGE_PLAYER] / frames,
+            (double) stats_total[STAGE_HUD] / frames);
+#endif
+#ifdef MAP_TILED
+    fprintf(stdout, "tile misses:        %lu (%d slots)\n", tile_misses, TILE_CACHE_SLOTS);
+#endif
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,334 @@
+/**
+ *      CTextMovingMap - host/cpu6502.c
+ *      ===============================
+ * 
+ *      Coeur 6502 au cycle près (NMOS, instructions officielles uniquement):
+ *      - nombre de cycles de base de chaque instruction (table cycles[])
+ *      - +1 cycle en cas de franchissement de page pour les LECTURES en abs,X / abs,Y / (zp),Y
+ *      - branchements: +1 cycle si pris, +1 de plus si la cible est dans une autre page
+ *      Pas d'interruption (IRQ/NMI): le profileur n'exécute que le code du programme.
+ */
+
+#include "cpu6502.h"
+
+
+/* ================== TABLES ================== */
+
+// mode d'adressage de chaque opcode
+enum { IMP, ACC, IMM, ZP, ZPX, ZPY, ABS, ABX, ABY, IND, IZX, IZY, REL, ILL };
+
+static const byte modes[256] = {
+/*        0    1    2    3    4    5    6    7    8    9    A    B    C    D    E    F */
+/* 0 */ IMP, IZX, ILL, ILL, ILL, ZP,  ZP,  ILL, IMP, IMM, ACC, ILL, ILL, ABS, ABS, ILL,
+/* 1 */ REL, IZY, ILL, ILL, ILL, ZPX, ZPX, ILL, IMP, ABY, ILL, ILL, ILL, ABX, ABX, ILL,
+/* 2 */ ABS, IZX, ILL, ILL, ZP,  ZP,  ZP,  ILL, IMP, IMM, ACC, ILL, ABS, ABS, ABS, ILL,
+/* 3 */ REL, IZY, ILL, ILL, ILL, ZPX, ZPX, ILL, IMP, ABY, ILL, ILL, ILL, ABX, ABX, ILL,
+/* 4 */ IMP, IZX, ILL, ILL, ILL, ZP,  ZP,  ILL, IMP, IMM, ACC, ILL, ABS, ABS, ABS, ILL,
+/* 5 */ REL, IZY, ILL, ILL, ILL, ZPX, ZPX, ILL, IMP, ABY, ILL, ILL, ILL, ABX, ABX, ILL,
+/* 6 */ IMP, IZX, ILL, ILL, ILL, ZP,  ZP,  ILL, IMP, IMM, ACC, ILL, IND, ABS, ABS, ILL,
+/* 7 */ REL, IZY, ILL, ILL, ILL, ZPX, ZPX, ILL, IMP, ABY, ILL, ILL, ILL, ABX, ABX, ILL,
+/* 8 */ ILL, IZX, ILL, ILL, ZP,  ZP,  ZP,  ILL, IMP, ILL, IMP, ILL, ABS, ABS, ABS, ILL,
+/* 9 */ REL, IZY, ILL, ILL, ZPX, ZPX, ZPY, ILL, IMP, ABY, IMP, ILL, ILL, ABX, ILL, ILL,
+/* A */ IMM, IZX, IMM, ILL, ZP,  ZP,  ZP,  ILL, IMP, IMM, IMP, ILL, ABS, ABS, ABS, ILL,
+/* B */ REL, IZY, ILL, ILL, ZPX, ZPX, ZPY, ILL, IMP, ABY, IMP, ILL, ABX, ABX, ABY, ILL,
+/* C */ IMM, IZX, ILL, ILL, ZP,  ZP,  ZP,  ILL, IMP, IMM, IMP, ILL, ABS, ABS, ABS, ILL,
+/* D */ REL, IZY, ILL, ILL, ILL, ZPX, ZPX, ILL, IMP, ABY, ILL, ILL, ILL, ABX, ABX, ILL,
+/* E */ IMM, IZX, ILL, ILL, ZP,  ZP,  ZP,  ILL, IMP, IMM, IMP, ILL, ABS, ABS, ABS, ILL,
+/* F */ REL, IZY, ILL, ILL, ILL, ZPX, ZPX, ILL, IMP, ABY, ILL, ILL, ILL, ABX, ABX, ILL
+};
+
+// nombre de cycles de base (hors franchissement de page / branchement pris)
+static const byte cycles[256] = {
+/*      0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F */
+/* 0 */ 7, 6, 0, 0, 0, 3, 5, 0, 3, 2, 2, 0, 0, 4, 6, 0,
+/* 1 */ 2, 5, 0, 0, 0, 4, 6, 0, 2, 4, 0, 0, 0, 4, 7, 0,
+/* 2 */ 6, 6, 0, 0, 3, 3, 5, 0, 4, 2, 2, 0, 4, 4, 6, 0,
+/* 3 */ 2, 5, 0, 0, 0, 4, 6, 0, 2, 4, 0, 0, 0, 4, 7, 0,
+/* 4 */ 6, 6, 0, 0, 0, 3, 5, 0, 3, 2, 2, 0, 3, 4, 6, 0,
+/* 5 */ 2, 5, 0, 0, 0, 4, 6, 0, 2, 4, 0, 0, 0, 4, 7, 0,
+/* 6 */ 6, 6, 0, 0, 0, 3, 5, 0, 4, 2, 2, 0, 5, 4, 6, 0,
+/* 7 */ 2, 5, 0, 0, 0, 4, 6, 0, 2, 4, 0, 0, 0, 4, 7, 0,
+/* 8 */ 0, 6, 0, 0, 3, 3, 3, 0, 2, 0, 2, 0, 4, 4, 4, 0,
+/* 9 */ 2, 6, 0, 0, 4, 4, 4, 0, 2, 5, 2, 0, 0, 5, 0, 0,
+/* A */ 2, 6, 2, 0, 3, 3, 3, 0, 2, 2, 2, 0, 4, 4, 4, 0,
+/* B */ 2, 5, 0, 0, 4, 4, 4, 0, 2, 4, 2, 0, 4, 4, 4, 0,
+/* C */ 2, 6, 0, 0, 3, 3, 5, 0, 2, 2, 2, 0, 4, 4, 6, 0,
+/* D */ 2, 5, 0, 0, 0, 4, 6, 0, 2, 4, 0, 0, 0, 4, 7, 0,
+/* E */ 2, 6, 0, 0, 3, 3, 5, 0, 2, 2, 2, 0, 4, 4, 6, 0,
+/* F */ 2, 5, 0, 0, 0, 4, 6, 0, 2, 4, 0, 0, 0, 4, 7, 0
+};
+
+static const byte sizes[] = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 2, 2, 2, 1 };
+
+
+/* ================== ACCES MEMOIRE ================== */
+
+static byte rd(cpu6502 *cpu, word addr) {
+    if(cpu->io[addr] && cpu->io_read != 0) return cpu->io_read(addr);
+    return cpu->mem[addr];
+}
+
+static void wr(cpu6502 *cpu, word addr, byte value) {
+    if(cpu->io[addr] && cpu->io_write != 0) { cpu->io_write(addr, value); return; }
+    cpu->mem[addr] = value;
+}
+
+static word rd16(cpu6502 *cpu, word addr) {
+    return (word) (rd(cpu, addr) | (rd(cpu, (word) (addr + 1)) << 8));
+}
+
+// lecture 16 bits en page zéro (l'octet de poids fort "boucle" dans la page zéro)
+static word rd16_zp(cpu6502 *cpu, byte addr) {
+    return (word) (cpu->mem[addr] | (cpu->mem[(byte) (addr + 1)] << 8));
+}
+
+static void push(cpu6502 *cpu, byte value) {
+    cpu->mem[0x100 | cpu->sp] = value;
+    cpu->sp--;
+}
+
+static byte pull(cpu6502 *cpu) {
+    cpu->sp++;
+    return cpu->mem[0x100 | cpu->sp];
+}
+
+#define set_nz(cpu, v) ((cpu)->p = (byte) (((cpu)->p & ~(FLAG_N|FLAG_Z)) \
+                                 | ((v) & FLAG_N) | (((v) & 0xFF) == 0 ? FLAG_Z : 0)))
+#define set_flag(cpu, f, cond) ((cpu)->p = (byte) ((cond) ? ((cpu)->p | (f)) : ((cpu)->p & ~(f))))
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+void cpu_reset(cpu6502 *cpu, word pc) {
+    cpu->pc = pc;
+    cpu->a = cpu->x = cpu->y = 0;
+    cpu->sp = 0xFF;
+    cpu->p = FLAG_U | FLAG_I;
+    cpu->cycles = 0;
+}
+
+int cpu_op_size(byte op) {
+    return sizes[modes[op]];
+}
+
+static void adc(cpu6502 *cpu, byte m) {
+    unsigned int c = cpu->p & FLAG_C;
+    unsigned int sum = cpu->a + m + c;
+
+    if(cpu->p & FLAG_D) {
+        unsigned int lo = (cpu->a & 0x0F) + (m & 0x0F) + c;
+        unsigned int hi = (cpu->a & 0xF0) + (m & 0xF0);
+        if(lo > 9) { lo += 6; hi += 0x10; }
+        set_flag(cpu, FLAG_V, (~(cpu->a ^ m) & (cpu->a ^ hi)) & 0x80);
+        if(hi > 0x90) hi += 0x60;
+        set_flag(cpu, FLAG_C, hi > 0xFF);
+        set_flag(cpu, FLAG_Z, (sum & 0xFF) == 0);
+        cpu->a = (byte) ((hi & 0xF0) | (lo & 0x0F));
+        set_flag(cpu, FLAG_N, cpu->a & 0x80);
+        return;
+    }
+    set_flag(cpu, FLAG_V, (~(cpu->a ^ m) & (cpu->a ^ sum)) & 0x80);
+    set_flag(cpu, FLAG_C, sum > 0xFF);
+    cpu->a = (byte) sum;
+    set_nz(cpu, cpu->a);
+}
+
+static void sbc(cpu6502 *cpu, byte m) {
+    unsigned int borrow = (cpu->p & FLAG_C) ? 0 : 1;
+    unsigned int diff = cpu->a - m - borrow;
+
+    set_flag(cpu, FLAG_V, ((cpu->a ^ m) & (cpu->a ^ diff)) & 0x80);
+    if(cpu->p & FLAG_D) {
+        int lo = (cpu->a & 0x0F) - (m & 0x0F) - (int) borrow;
+        int hi = (cpu->a >> 4) - (m >> 4);
+        if(lo < 0) { lo -= 6; hi--; }
+        if(hi < 0) hi -= 6;
+        set_flag(cpu, FLAG_C, diff < 0x100);
+        cpu->a = (byte) (((hi << 4) & 0xF0) | (lo & 0x0F));
+        set_nz(cpu, (byte) diff);
+        return;
+    }
+    set_flag(cpu, FLAG_C, diff < 0x100);
+    cpu->a = (byte) diff;
+    set_nz(cpu, cpu->a);
+}
+
+static void compare(cpu6502 *cpu, byte reg, byte m) {
+    unsigned int diff = reg - m;
+
+    set_flag(cpu, FLAG_C, reg >= m);
+    set_nz(cpu, (byte) diff);
+}
+
+int cpu_step(cpu6502 *cpu) {
+    byte op = rd(cpu, cpu->pc);
+    int  mode = modes[op];
+    int  n = cycles[op];
+    word addr = 0, base;
+    byte m, v;
+
+    {
+        word pc1 = (word) (cpu->pc + 1);
+
+        if(mode == ILL) return 0;
+
+        // calcul de l'adresse effective
+        switch(mode) {
+            case IMM: addr = pc1; break;
+            case ZP:  addr = rd(cpu, pc1); break;
+            case ZPX: addr = (byte) (rd(cpu, pc1) + cpu->x); break;
+            case ZPY: addr = (byte) (rd(cpu, pc1) + cpu->y); break;
+            case ABS: addr = rd16(cpu, pc1); break;
+            case ABX:
+                base = rd16(cpu, pc1); addr = (word) (base + cpu->x);
+                if((base ^ addr) & 0xFF00) n += (cycles[op] == 4 || op == 0xBE || op == 0xBC) ? 1 : 0;
+                break;
+            case ABY:
+                base = rd16(cpu, pc1); addr = (word) (base + cpu->y);
+                if((base ^ addr) & 0xFF00) n += (cycles[op] == 4) ? 1 : 0;
+                break;
+            case IND:
+                // bug du 6502: JMP ($xxFF) lit l'octet de poids fort en $xx00
+                base = rd16(cpu, pc1);
+                addr = (word) (rd(cpu, base) | (rd(cpu, (word) ((base & 0xFF00) | ((base + 1) & 0xFF))) << 8));
+                break;
+            case IZX: addr = rd16_zp(cpu, (byte) (rd(cpu, pc1) + cpu->x)); break;
+            case IZY:
+                base = rd16_zp(cpu, rd(cpu, pc1)); addr = (word) (base + cpu->y);
+                if((base ^ addr) & 0xFF00) n += (op != 0x91) ? 1 : 0;
+                break;
+            case REL: addr = (word) (cpu->pc + 2 + (signed char) rd(cpu, pc1)); break;
+        }
+        cpu->pc = (word) (cpu->pc + sizes[mode]);
+    }
+
+    switch(op) {
+        // chargements / rangements
+        case 0xA9: case 0xA5: case 0xB5: case 0xAD: case 0xBD: case 0xB9: case 0xA1: case 0xB1:
+            cpu->a = rd(cpu, addr); set_nz(cpu, cpu->a); break;
+        case 0xA2: case 0xA6: case 0xB6: case 0xAE: case 0xBE:
+            cpu->x = rd(cpu, addr); set_nz(cpu, cpu->x); break;
+        case 0xA0: case 0xA4: case 0xB4: case 0xAC: case 0xBC:
+            cpu->y = rd(cpu, addr); set_nz(cpu, cpu->y); break;
+        case 0x85: case 0x95: case 0x8D: case 0x9D: case 0x99: case 0x81: case 0x91:
+            wr(cpu, addr, cpu->a); break;
+        case 0x86: case 0x96: case 0x8E: wr(cpu, addr, cpu->x); break;
+        case 0x84: case 0x94: case 0x8C: wr(cpu, addr, cpu->y); break;
+
+        // transferts
+        case 0xAA: cpu->x = cpu->a; set_nz(cpu, cpu->x); break;
+        case 0xA8: cpu->y = cpu->a; set_nz(cpu, cpu->y); break;
+        case 0x8A: cpu->a = cpu->x; set_nz(cpu, cpu->a); break;
+        case 0x98: cpu->a = cpu->y; set_nz(cpu, cpu->a); break;
+        case 0xBA: cpu->x = cpu->sp; set_nz(cpu, cpu->x); break;
+        case 0x9A: cpu->sp = cpu->x; break;
+
+        // pile
+        case 0x48: push(cpu, cpu->a); break;
+        case 0x08: push(cpu, (byte) (cpu->p | FLAG_B | FLAG_U)); break;
+        case 0x68: cpu->a = pull(cpu); set_nz(cpu, cpu->a); break;
+        case 0x28: cpu->p = (byte) ((pull(cpu) & ~FLAG_B) | FLAG_U); break;
+
+        // logique
+        case 0x29: case 0x25: case 0x35: case 0x2D: case 0x3D: case 0x39: case 0x21: case 0x31:
+            cpu->a &= rd(cpu, addr); set_nz(cpu, cpu->a); break;
+        case 0x09: case 0x05: case 0x15: case 0x0D: case 0x1D: case 0x19: case 0x01: case 0x11:
+            cpu->a |= rd(cpu, addr); set_nz(cpu, cpu->a); break;
+        case 0x49: case 0x45: case 0x55: case 0x4D: case 0x5D: case 0x59: case 0x41: case 0x51:
+            cpu->a ^= rd(cpu, addr); set_nz(cpu, cpu->a); break;
+        case 0x24: case 0x2C:
+            m = rd(cpu, addr);
+            set_flag(cpu, FLAG_Z, (cpu->a & m) == 0);
+            cpu->p = (byte) ((cpu->p & ~(FLAG_N|FLAG_V)) | (m & (FLAG_N|FLAG_V)));
+            break;
+
+        // arithmétique
+        case 0x69: case 0x65: case 0x75: case 0x6D: case 0x7D: case 0x79: case 0x61: case 0x71:
+            adc(cpu, rd(cpu, addr)); break;
+        case 0xE9: case 0xE5: case 0xF5: case 0xED: case 0xFD: case 0xF9: case 0xE1: case 0xF1:
+            sbc(cpu, rd(cpu, addr)); break;
+        case 0xC9: case 0xC5: case 0xD5: case 0xCD: case 0xDD: case 0xD9: case 0xC1: case 0xD1:
+            compare(cpu, cpu->a, rd(cpu, addr)); break;
+        case 0xE0: case 0xE4: case 0xEC: compare(cpu, cpu->x, rd(cpu, addr)); break;
+        case 0xC0: case 0xC4: case 0xCC: compare(cpu, cpu->y, rd(cpu, addr)); break;
+
+        // incréments / décréments
+        case 0xE6: case 0xF6: case 0xEE: case 0xFE:
+            v = (byte) (rd(cpu, addr) + 1); wr(cpu, addr, v); set_nz(cpu, v); break;
+        case 0xC6: case 0xD6: case 0xCE: case 0xDE:
+            v = (byte) (rd(cpu, addr) - 1); wr(cpu, addr, v); set_nz(cpu, v); break;
+        case 0xE8: cpu->x++; set_nz(cpu, cpu->x); break;
+        case 0xC8: cpu->y++; set_nz(cpu, cpu->y); break;
+        case 0xCA: cpu->x--; set_nz(cpu, cpu->x); break;
+        case 0x88: cpu->y--; set_nz(cpu, cpu->y); break;
+
+        // décalages / rotations
+        case 0x0A: set_flag(cpu, FLAG_C, cpu->a & 0x80); cpu->a <<= 1; set_nz(cpu, cpu->a); break;
+        case 0x4A: set_flag(cpu, FLAG_C, cpu->a & 0x01); cpu->a >>= 1; set_nz(cpu, cpu->a); break;
+        case 0x2A:
+            v = (byte) ((cpu->a << 1) | (cpu->p & FLAG_C));
+            set_flag(cpu, FLAG_C, cpu->a & 0x80); cpu->a = v; set_nz(cpu, v); break;
+        case 0x6A:
+            v = (byte) ((cpu->a >> 1) | ((cpu->p & FLAG_C) << 7));
+            set_flag(cpu, FLAG_C, cpu->a & 0x01); cpu->a = v; set_nz(cpu, v); break;
+        case 0x06: case 0x16: case 0x0E: case 0x1E:
+            m = rd(cpu, addr); set_flag(cpu, FLAG_C, m & 0x80);
+            v = (byte) (m << 1); wr(cpu, addr, v); set_nz(cpu, v); break;
+        case 0x46: case 0x56: case 0x4E: case 0x5E:
+            m = rd(cpu, addr); set_flag(cpu, FLAG_C, m & 0x01);
+            v = (byte) (m >> 1); wr(cpu, addr, v); set_nz(cpu, v); break;
+        case 0x26: case 0x36: case 0x2E: case 0x3E:
+            m = rd(cpu, addr); v = (byte) ((m << 1) | (cpu->p & FLAG_C));
+            set_flag(cpu, FLAG_C, m & 0x80); wr(cpu, addr, v); set_nz(cpu, v); break;
+        case 0x66: case 0x76: case 0x6E: case 0x7E:
+            m = rd(cpu, addr); v = (byte) ((m >> 1) | ((cpu->p & FLAG_C) << 7));
+            set_flag(cpu, FLAG_C, m & 0x01); wr(cpu, addr, v); set_nz(cpu, v); break;
+
+        // sauts / sous-programmes
+        case 0x4C: case 0x6C: cpu->pc = addr; break;
+        case 0x20:
+            base = (word) (cpu->pc - 1);
+            push(cpu, (byte) (base >> 8)); push(cpu, (byte) base);
+            cpu->pc = addr;
+            break;
+        case 0x60:
+            base = pull(cpu); base |= (word) (pull(cpu) << 8);
+            cpu->pc = (word) (base + 1);
+            break;
+        case 0x40:
+            cpu->p = (byte) ((pull(cpu) & ~FLAG_B) | FLAG_U);
+            base = pull(cpu); base |= (word) (pull(cpu) << 8);
+            cpu->pc = base;
+            break;
+        case 0x00:
+            base = (word) (cpu->pc + 1);
+            push(cpu, (byte) (base >> 8)); push(cpu, (byte) base);
+            push(cpu, (byte) (cpu->p | FLAG_B | FLAG_U));
+            cpu->p |= FLAG_I;
+            cpu->pc = rd16(cpu, 0xFFFE);
+            break;
+
+        // branchements
+        case 0x10: case 0x30: case 0x50: case 0x70: case 0x90: case 0xB0: case 0xD0: case 0xF0: {
+            static const byte flag_of[4] = { FLAG_N, FLAG_V, FLAG_C, FLAG_Z };
+            if(((cpu->p & flag_of[op >> 6]) != 0) == ((op & 0x20) != 0)) {
+                n += ((cpu->pc ^ addr) & 0xFF00) ? 2 : 1;
+                cpu->pc = addr;
+            }
+            break;
+        }
+
+        // drapeaux
+        case 0x18: cpu->p &= ~FLAG_C; break;
+        case 0x38: cpu->p |= FLAG_C; break;
+        case 0x58: cpu->p &= ~FLAG_I; break;
+        case 0x78: cpu->p |= FLAG_I; break;
+        case 0xB8: cpu->p &= ~FLAG_V; break;
+        case 0xD8: cpu->p &= ~FLAG_D; break;
+        case 0xF8: cpu->p |= FLAG_D; break;
+
+        case 0xEA: break;
+    }
+    cpu->cycles += n;
+    return n;
+}
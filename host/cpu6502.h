@@ -0,0 +1,45 @@
+/**
+ *      CTextMovingMap - host/cpu6502.h
+ *      ===============================
+ * 
+ *      Coeur 6502 (NMOS, instructions officielles) au cycle près, utilisé par le profileur
+ *      (host/prof6502.c) pour exécuter sur PC le code compilé par OSDK (fichier .tap)
+ */
+
+#ifndef CPU6502_H
+#define CPU6502_H
+
+typedef unsigned char  byte;
+typedef unsigned short word;
+
+typedef struct {
+    word pc;
+    byte a, x, y, sp, p;
+    unsigned long long cycles;  // nombre total de cycles exécutés
+    byte mem[0x10000];
+    // lecture/écriture d'une adresse "matérielle" (entrées/sorties...): si non NULL, appelées
+    // pour les adresses dont le drapeau io[] est non nul
+    byte (*io_read)(word addr);
+    void (*io_write)(word addr, byte value);
+    byte io[0x10000];
+} cpu6502;
+
+// drapeaux du registre P
+#define FLAG_C 0x01
+#define FLAG_Z 0x02
+#define FLAG_I 0x04
+#define FLAG_D 0x08
+#define FLAG_B 0x10
+#define FLAG_U 0x20
+#define FLAG_V 0x40
+#define FLAG_N 0x80
+
+void cpu_reset(cpu6502 *cpu, word pc);
+
+// exécute une instruction, renvoie son nombre de cycles (0 si opcode illégal)
+int  cpu_step(cpu6502 *cpu);
+
+// taille en octets de l'instruction de code opération op (1 à 3)
+int  cpu_op_size(byte op);
+
+#endif /* CPU6502_H */
@@ -0,0 +1,29 @@
+/**
+ *      CTextMovingMap - host/host_platform.h
+ *      =====================================
+ * 
+ *      Fonctions propres à la plateforme "hôte" (PC): pilotage du clavier scripté,
+ *      fichier du support externe, vidage de l'écran simulé
+ */
+
+#ifndef HOST_PLATFORM_H
+#define HOST_PLATFORM_H
+
+#include "../movingmap.h"
+
+// fournit la suite de touches renvoyées par read_key(); une fois épuisée, read_key() renvoie KEY_ESC
+void host_set_keys(const uchar *keys, unsigned long count);
+
+// fonction appelée à chaque lecture du clavier (NULL = aucune), AVANT de renvoyer la touche:
+// permet au banc de mesure de délimiter les frames de play_map()
+extern void (*host_on_key_read)();
+
+// fichiers du support de stockage externe (store_open() / store_create()): STORE_DATA (par défaut le
+// monde du mode MAP_TILED, ou le niveau de make level avec MAP_FILE) et STORE_SAVE (partie sauvegardée)
+extern const char *host_store_file;
+extern const char *host_save_file;
+
+// affiche le contenu de l'écran simulé (une ligne de texte par ligne d'écran)
+void host_dump_screen(FILE *out);
+
+#endif /* HOST_PLATFORM_H */
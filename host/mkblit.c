@@ -0,0 +1,105 @@
+/**
+ *      CTextMovingMap - host/mkblit.c
+ *      ==============================
+ *
+ *      Génération de blit_gen.c: routines d'affichage de la carte spécialisées pour la géométrie
+ *      configurée dans movingmap.h (WIN_XSIZE x WIN_YSIZE), entièrement déroulées:
+ *      - blit_row_even() / blit_row_odd(): une ligne de la fenêtre, pour xv pair / impair
+ *        (décalages écran et carte constants, plus de compteur de boucle ni de test de parité)
+ *      - blit_window_even() / blit_window_odd(): toute la fenêtre en mode MAP_DENSE, avec les
+ *        adresses écran (ou tampon) constantes et le pas d'une ligne de la carte (MAP_XSIZE/2)
+ *      Les adresses sont écrites sous forme symbolique (WIN_ADDR, SCREEN_WIDTH, MAP_XSIZE): le fichier
+ *      généré ne dépend que des dimensions de la fenêtre, vérifiées à la compilation.
+ *
+ *      Utilisé par render.c avec l'option BLIT_GEN (voir movingmap.h).
+ *
+ *      Usage: mkblit [-o fichier]   (par défaut blit_gen.c)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "../movingmap.h"
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/**
+ * emit_row(f, dest, offset, odd): corps déroulé de l'affichage d'une ligne de WIN_XSIZE cases
+ * vers dest[offset...], à partir de l'octet cell_addr[0] (qui contient la 1ère case, de parité odd)
+ */
+static void emit_row(FILE *f, const char *dest, const char *offset, int odd) {
+    int col = 0, byte = 0;
+
+    if(odd) {
+        fprintf(f, "    %s[%s%d] = cell_char_odd[(uchar) cell_addr[0]];\n", dest, offset, col++);
+        byte++;
+    }
+    for(; col + 1 < WIN_XSIZE; col += 2, byte++) {
+        fprintf(f, "    c = (uchar) cell_addr[%d]; %s[%s%d] = cell_char_even[c]; %s[%s%d] = cell_char_odd[c];\n",
+                byte, dest, offset, col, dest, offset, col+1);
+    }
+    if(col < WIN_XSIZE) {
+        fprintf(f, "    %s[%s%d] = cell_char_even[(uchar) cell_addr[%d]];\n", dest, offset, col, byte);
+    }
+}
+
+static void emit_row_function(FILE *f, int odd) {
+    fprintf(f, "/** \n * blit_row_%s(addr, cell_addr): affichage à l'adresse addr des WIN_XSIZE cases à partir\n"
+               " * de l'octet cell_addr (xv %s)\n */\n", odd ? "odd" : "even", odd ? "impair" : "pair");
+    fprintf(f, "void blit_row_%s(char *addr, char *cell_addr) {\n    uchar c;\n\n", odd ? "odd" : "even");
+    emit_row(f, "addr", "", odd);
+    fprintf(f, "}\n\n");
+}
+
+static void emit_window_function(FILE *f, int odd) {
+    char offset[32];
+    int row;
+
+    fprintf(f, "/** \n * blit_window_%s(cell_addr): affichage de toute la fenêtre à partir de l'octet cell_addr\n"
+               " * du coin supérieur gauche (xv %s)\n */\n", odd ? "odd" : "even", odd ? "impair" : "pair");
+    fprintf(f, "void blit_window_%s(char *cell_addr) {\n    uchar c;\n\n", odd ? "odd" : "even");
+    for(row = 0; row < WIN_YSIZE; row++) {
+        fprintf(f, "    // ligne %d\n", row);
+        sprintf(offset, "%d*SCREEN_WIDTH+", row);
+        emit_row(f, "WIN_ADDR", offset, odd);
+        if(row < WIN_YSIZE-1) fprintf(f, "    cell_addr += MAP_XSIZE/2;\n");
+    }
+    fprintf(f, "}\n\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *filename = "blit_gen.c";
+    FILE *f;
+    int i;
+
+    for(i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-o") == 0 && i+1 < argc) filename = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [-o file]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    f = fopen(filename, "w");
+    if(f == NULL) { perror(filename); return 1; }
+
+    fprintf(f, "/**\n *      CTextMovingMap - blit_gen.c\n *      ===========================\n * \n");
+    fprintf(f, " *      GENERE par host/mkblit (make blit) pour une fenêtre de %dx%d cases: ne pas modifier.\n",
+            WIN_XSIZE, WIN_YSIZE);
+    fprintf(f, " *      Routines d'affichage de la carte entièrement déroulées (option BLIT_GEN, voir render.c)\n */\n\n");
+    fprintf(f, "#include \"movingmap.h\"\n\n#ifdef BLIT_GEN\n\n");
+    fprintf(f, "#if WIN_XSIZE != %d || WIN_YSIZE != %d\n", WIN_XSIZE, WIN_YSIZE);
+    fprintf(f, "#error \"blit_gen.c ne correspond pas a la fenetre configuree: le regenerer (make blit)\"\n#endif\n\n\n");
+    fprintf(f, "/* ================== IMPLEMENTATION DES FONCTIONS ================== */\n\n");
+
+    emit_row_function(f, 0);
+    emit_row_function(f, 1);
+    fprintf(f, "#ifdef MAP_DENSE\n\n");
+    emit_window_function(f, 0);
+    emit_window_function(f, 1);
+    fprintf(f, "#endif /* MAP_DENSE */\n\n#endif /* BLIT_GEN */\n");
+
+    fclose(f);
+    fprintf(stdout, "%s: fenetre %dx%d\n", filename, WIN_XSIZE, WIN_YSIZE); // (printf = écran simulé, voir platform.h)
+    return 0;
+}
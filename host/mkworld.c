@@ -0,0 +1,266 @@
+/**
+ *      CTextMovingMap - host/mkworld.c
+ *      ===============================
+ * 
+ *      Génération d'un grand monde: murs d'enceinte, puis arbres, montagnes "/\" et lacs de 4x3 cases
+ *      répartis au hasard avec la même densité que init_map() sur la carte 100x100, au format:
+ *      - "tiles" (par défaut): fichier de tuiles du mode MAP_TILED (voir tiles.c); les tuiles
+ *        entièrement vides partagent le bloc 0
+ *      - "rle": source C des données compressées du mode MAP_RLE (voir rle.c), à compiler avec le
+ *        moteur
+ *      - "map": fichier de carte de l'option MAP_FILE (voir mapfile.c), niveau chargé au démarrage
+ *        à la place de la carte générée (dimensions de map[][], ex. -w 100 -h 100)
+ * 
+ *      Usage: mkworld [-f tiles|rle|map] [-o fichier] [-w largeur] [-h hauteur] [-t taille_tuile] [-s graine]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* ================== CONSTANTES ================== */
+
+#define V_EMPTY 0
+#define V_WALL  1
+#define V_TREE  2
+#define V_WATER 3
+#define V_HILL1 4
+#define V_HILL2 5
+
+#define WORLD_HEADER_SIZE 16
+#define MAP_FILE_HEADER_SIZE 16
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+static unsigned char *cells; // 1 octet par cellule pendant la génération
+static unsigned int   width, height;
+static unsigned long  rand_state;
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+static unsigned int rnd(unsigned int max) {
+    rand_state = rand_state * 1103515245UL + 12345UL;
+    return (unsigned int) ((rand_state >> 8) % max);
+}
+
+#define cell(y, x) cells[(unsigned long) (y) * width + (x)]
+
+static void generate() {
+    unsigned long area = (unsigned long) width * height, k, n;
+    unsigned int x, y, r;
+
+    memset(cells, V_EMPTY, area);
+    for(x = 0; x < width; x++) { cell(0, x) = V_WALL; cell(height-1, x) = V_WALL; }
+    for(y = 0; y < height; y++) { cell(y, 0) = V_WALL; cell(y, width-1) = V_WALL; }
+
+    // densités de init_map(): ~225 arbres, ~80 montagnes et ~40 lacs pour 100x100 cases
+    n = area * 225 / 10000;
+    for(k = 0; k < n; k++) cell(1 + rnd(height-3), 1 + rnd(width-3)) = V_TREE;
+
+    n = area * 80 / 10000;
+    for(k = 0; k < n; k++) {
+        x = 1 + rnd(width-5); y = 1 + rnd(height-2);
+        if(x & 1) x++;  // montagne alignée sur une case paire, comme dans init_map()
+        cell(y, x) = V_HILL1; cell(y, x+1) = V_HILL2;
+    }
+
+    // lac: 3 lignes de 4 cases d'eau décalées d'une case à chaque ligne (même forme que
+    // init_map(), y compris les 2 cases vidées de part et d'autre de la 2e ligne)
+    n = area * 40 / 10000;
+    for(k = 0; k < n; k++) {
+        x = (1 + rnd(width-8)) & ~1u; y = 1 + rnd(height-5);
+        for(r = 0; r < 3; r++) {
+            cell(y+r, x+r) = V_WATER; cell(y+r, x+r+1) = V_WATER;
+            cell(y+r, x+r+2) = V_WATER; cell(y+r, x+r+3) = V_WATER;
+        }
+        if(x > 0) cell(y+1, x) = V_EMPTY;
+        cell(y+1, x+5) = V_EMPTY;
+    }
+}
+
+/**
+ * write_rle(): écriture du source C de la carte compressée ligne par ligne (format de rle.c)
+ */
+static int write_rle(const char *filename) {
+    FILE *f = fopen(filename, "w");
+    unsigned long total = 0, *rows = malloc((height + 1) * sizeof(unsigned long));
+    unsigned int x, y, len, chunk, col = 0;
+    unsigned char v;
+
+    if(f == NULL) { perror(filename); return 1; }
+    fprintf(f, "/* Carte compressee %ux%u generee par host/mkworld -f rle: ne pas modifier */\n\n", width, height);
+    fprintf(f, "#include \"movingmap.h\"\n\n");
+    fprintf(f, "#if MAP_XSIZE != %u || MAP_YSIZE != %u\n", width, height);
+    fprintf(f, "#error \"carte compressee incompatible avec MAP_XSIZE / MAP_YSIZE\"\n#endif\n\n");
+    fprintf(f, "uchar map_rle_data[] = {");
+    for(y = 0; y < height; y++) {
+        rows[y] = total;
+        for(x = 0; x < width; x += len) {
+            v = cell(y, x);
+            for(len = 1; x + len < width && cell(y, x + len) == v; len++) ;
+            // un run trop long est découpé en plusieurs runs de 16 + 255 cellules au plus
+            for(chunk = 0; chunk < len; ) {
+                unsigned int n = len - chunk;
+                if(n > 16 + 255) n = 16 + 255;
+                if(col++ % 16 == 0) fprintf(f, "\n   ");
+                if(n < 16) {
+                    fprintf(f, " 0x%02X,", (v << 4) | (n - 1));
+                    total++;
+                }
+                else {
+                    fprintf(f, " 0x%02X, %u,", (v << 4) | 15, n - 16);
+                    total += 2;
+                }
+                chunk += n;
+            }
+        }
+    }
+    rows[height] = total;
+    fprintf(f, "\n};\n\nunsigned int map_rle_rows[MAP_YSIZE+1] = {");
+    for(y = 0; y <= height; y++) {
+        if(y % 12 == 0) fprintf(f, "\n   ");
+        fprintf(f, " %lu,", rows[y]);
+    }
+    fprintf(f, "\n};\n");
+    fclose(f);
+
+    printf("%s: %ux%u cellules, %lu octets compresses + %lu octets d'index (au lieu de %lu)\n",
+           filename, width, height, total, 2UL * (height + 1), (unsigned long) width * height / 2);
+    free(rows);
+    return 0;
+}
+
+static void put16(unsigned char *addr, unsigned int value) {
+    addr[0] = (unsigned char) value;
+    addr[1] = (unsigned char) (value >> 8);
+}
+
+/**
+ * write_map(): écriture du fichier de carte de l'option MAP_FILE (format de mapfile.c): en-tête,
+ * index des lignes, lignes de 2 cellules par octet; départ au centre de la carte
+ */
+static int write_map(const char *filename, unsigned long seed) {
+    FILE *f = fopen(filename, "wb");
+    unsigned char header[MAP_FILE_HEADER_SIZE], entry[2], *row = malloc(width / 2);
+    unsigned int x, y, rows = MAP_FILE_HEADER_SIZE + 2 * height;
+
+    if(f == NULL) { perror(filename); return 1; }
+    memset(header, 0, sizeof(header));
+    memcpy(header, "MMD1", 4);
+    put16(header + 4, width);
+    put16(header + 6, height);
+    put16(header + 8, (unsigned int) seed);
+    put16(header + 10, width / 2);
+    put16(header + 12, height / 2);
+    fwrite(header, 1, sizeof(header), f);
+    for(y = 0; y < height; y++) {
+        put16(entry, rows + y * (width / 2));
+        fwrite(entry, 1, 2, f);
+    }
+    for(y = 0; y < height; y++) {
+        for(x = 0; x < width; x += 2) row[x / 2] = (unsigned char) ((cell(y, x) << 4) | cell(y, x + 1));
+        fwrite(row, 1, width / 2, f);
+    }
+    fclose(f);
+
+    printf("%s: carte %ux%u, %u octets\n", filename, width, height, rows + height * (width / 2));
+    free(row);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *filename = NULL, *format = "tiles";
+    unsigned int tile = 16, tiles_x, tiles_y, tx, ty, ty2, tx2, block, nb_blocks = 1;
+    unsigned long seed = 1, tile_bytes;
+    unsigned char header[WORLD_HEADER_SIZE], *dir, *data, *t;
+    FILE *f;
+    int i, empty;
+
+    width = height = 1024;
+    for(i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-f") == 0 && i+1 < argc) format = argv[++i];
+        else if(strcmp(argv[i], "-o") == 0 && i+1 < argc) filename = argv[++i];
+        else if(strcmp(argv[i], "-w") == 0 && i+1 < argc) width = (unsigned int) strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "-h") == 0 && i+1 < argc) height = (unsigned int) strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "-t") == 0 && i+1 < argc) tile = (unsigned int) strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "-s") == 0 && i+1 < argc) seed = strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "usage: %s [-f tiles|rle|map] [-o file] [-w width] [-h height] [-t tile_size] [-s seed]\n", argv[0]);
+            return 2;
+        }
+    }
+    if((strcmp(format, "tiles") == 0 && (tile < 2 || (tile & 1) || width % tile || height % tile))
+    || (width & 1) || width < 10 || height < 8 || width > 65535 || height > 65535) {
+        fprintf(stderr, "dimensions invalides: %ux%u, tuiles de %u\n", width, height, tile);
+        return 2;
+    }
+
+    if(strcmp(format, "tiles") != 0 && strcmp(format, "rle") != 0 && strcmp(format, "map") != 0) {
+        fprintf(stderr, "format inconnu: %s\n", format);
+        return 2;
+    }
+    if(strcmp(format, "map") == 0 && (width > 254 || height > 255)) {
+        fprintf(stderr, "carte trop grande pour MAP_FILE: %ux%u\n", width, height);
+        return 2;
+    }
+
+    rand_state = seed;
+    cells = malloc((unsigned long) width * height);
+    generate();
+
+    if(strcmp(format, "rle") == 0) {
+        i = write_rle(filename != NULL ? filename : "BUILD/host/map_rle_data.c");
+        free(cells);
+        return i;
+    }
+    if(strcmp(format, "map") == 0) {
+        i = write_map(filename != NULL ? filename : "BUILD/host/level.map", seed);
+        free(cells);
+        return i;
+    }
+    if(filename == NULL) filename = "BUILD/host/world.bin";
+
+    tiles_x = width / tile; tiles_y = height / tile;
+    tile_bytes = (unsigned long) tile * tile / 2;
+    dir  = calloc((unsigned long) tiles_x * tiles_y, 2);
+    data = calloc((unsigned long) tiles_x * tiles_y + 1, tile_bytes); // bloc 0 = tuile vide
+
+    for(ty = 0; ty < tiles_y; ty++) {
+        for(tx = 0; tx < tiles_x; tx++) {
+            t = data + nb_blocks * tile_bytes;
+            empty = 1;
+            for(ty2 = 0; ty2 < tile; ty2++) {
+                for(tx2 = 0; tx2 < tile; tx2 += 2) {
+                    unsigned char hi = cell(ty*tile + ty2, tx*tile + tx2);
+                    unsigned char lo = cell(ty*tile + ty2, tx*tile + tx2 + 1);
+                    *t++ = (unsigned char) ((hi << 4) | lo);
+                    if(hi != V_EMPTY || lo != V_EMPTY) empty = 0;
+                }
+            }
+            block = empty ? 0 : nb_blocks++;
+            put16(dir + 2UL * ((unsigned long) ty * tiles_x + tx), block);
+        }
+    }
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, "MMW1", 4);
+    put16(header + 4, width);
+    put16(header + 6, height);
+    header[8] = (unsigned char) tile;
+
+    f = fopen(filename, "wb");
+    if(f == NULL) { perror(filename); return 1; }
+    fwrite(header, 1, sizeof(header), f);
+    fwrite(dir, 2, (unsigned long) tiles_x * tiles_y, f);
+    fwrite(data, tile_bytes, nb_blocks, f);
+    fclose(f);
+
+    printf("%s: %ux%u cellules, %u tuiles dont %u non vides, %lu octets\n", filename, width, height,
+           tiles_x * tiles_y, nb_blocks - 1,
+           WORLD_HEADER_SIZE + 2UL * tiles_x * tiles_y + nb_blocks * tile_bytes);
+    free(cells); free(dir); free(data);
+    return 0;
+}
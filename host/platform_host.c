@@ -0,0 +1,192 @@
+/**
+ *      CTextMovingMap - host/platform_host.c
+ *      =====================================
+ * 
+ *      Implémentation "hôte" (PC) de la couche plateforme (voir platform.h):
+ *      écran TEXT 40x28 en RAM, clavier scripté,
+ *      support de stockage externe = fichier, timer (FRAME_STATS) = horloge monotone
+ */
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <time.h>
+#include "host_platform.h"
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+char  host_text_screen[SCREEN_WIDTH*SCREEN_HEIGHT];
+uchar host_cursor_flags = 1;
+uchar host_sys_timer = 0;
+unsigned long host_bytes_written = 0;
+
+void (*host_on_key_read)() = NULL;
+
+static const uchar  *script_keys;
+static unsigned long script_count, script_pos;
+
+#ifdef MAP_FILE
+const char *host_store_file = "BUILD/host/level.map";
+#else
+const char *host_store_file = "BUILD/host/world.bin";
+#endif
+const char *host_save_file = "BUILD/host/session.map";
+static FILE *store;
+static const char *store_name;      // fichier ouvert (messages d'erreur)
+
+// position du curseur texte (pour printf)
+static uchar cursor_x, cursor_y;
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+void host_set_keys(const uchar *keys, unsigned long count) {
+    script_keys = keys;
+    script_count = count;
+    script_pos = 0;
+}
+
+uchar host_read_key() {
+    if(host_on_key_read != NULL) host_on_key_read();
+    host_sys_timer--;
+    if(script_pos < script_count) return script_keys[script_pos++];
+    return KEY_ESC;
+}
+
+uchar host_sample_key() {
+    if(script_pos < script_count) return script_keys[script_pos];
+    return KEY_ESC;
+}
+
+unsigned int host_timer_read() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned int) -(ts.tv_sec * 1000000L + ts.tv_nsec / 1000);
+}
+
+/**
+ * scroll_screen(): décale l'écran d'une ligne vers le haut (quand printf atteint le bas de l'écran)
+ */
+static void scroll_screen() {
+    char *addr = host_text_screen;
+    int i;
+
+    for(i = 0; i < SCREEN_WIDTH*(SCREEN_HEIGHT-1); i++) {
+        addr[i] = addr[i+SCREEN_WIDTH];
+    }
+    for(; i < SCREEN_WIDTH*SCREEN_HEIGHT; i++) {
+        addr[i] = ' ';
+    }
+}
+
+int host_printf(const char *format, ...) {
+    char buffer[256];
+    va_list args;
+    int i, len;
+
+    va_start(args, format);
+    len = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if(len > (int) sizeof(buffer) - 1) len = sizeof(buffer) - 1;
+    count_writes(len);
+
+    for(i = 0; i < len; i++) {
+        if(buffer[i] != '\n') {
+            host_text_screen[cursor_y*SCREEN_WIDTH + cursor_x] = buffer[i];
+            cursor_x++;
+        }
+        if(buffer[i] == '\n' || cursor_x >= SCREEN_WIDTH) {
+            cursor_x = 0;
+            if(cursor_y < SCREEN_HEIGHT-1) cursor_y++; else scroll_screen();
+        }
+    }
+    return len;
+}
+
+bool store_open(uchar file) {
+    if(store != NULL) fclose(store);
+    store_name = (file == STORE_SAVE) ? host_save_file : host_store_file;
+    store = fopen(store_name, "rb");
+    return store != NULL;
+}
+
+/**
+ * store_read(): FALSE si la lecture est impossible (fichier tronqué): à l'appelant de rejeter le
+ * fichier
+ */
+bool store_read(unsigned long offset, char *buffer, unsigned int length) {
+    return fseek(store, (long) offset, SEEK_SET) == 0 && fread(buffer, 1, length, store) == length;
+}
+
+unsigned long store_size() {
+    long size;
+
+    if(fseek(store, 0, SEEK_END) != 0 || (size = ftell(store)) < 0) return 0;
+    return (unsigned long) size;
+}
+
+/**
+ * store_create(): création (ou remise à zéro) du fichier, ouvert en lecture et écriture
+ */
+bool store_create(uchar file) {
+    if(store != NULL) fclose(store);
+    store_name = (file == STORE_SAVE) ? host_save_file : host_store_file;
+    store = fopen(store_name, "w+b");
+    return store != NULL;
+}
+
+/**
+ * store_write(): une écriture impossible est une erreur fatale
+ */
+void store_write(unsigned long offset, char *buffer, unsigned int length) {
+    if(fseek(store, (long) offset, SEEK_SET) != 0 || fwrite(buffer, 1, length, store) != length) {
+        fprintf(stderr, "%s: ecriture impossible (offset %lu, %u octets)\n", store_name, offset, length);
+        exit(1);
+    }
+}
+
+void text() {
+}
+
+/**
+ * wait_vsync(): pas de synchro d'affichage sur PC (l'écran simulé n'est pas "balayé")
+ */
+void wait_vsync() {
+}
+
+void cls() {
+    int i;
+
+    for(i = 0; i < SCREEN_WIDTH*SCREEN_HEIGHT; i++) {
+        host_text_screen[i] = ' ';
+    }
+    count_writes(SCREEN_WIDTH*SCREEN_HEIGHT);
+    cursor_x = 0; cursor_y = 0;
+}
+
+void paper(uchar color) {
+    (void) color;
+}
+
+void ink(uchar color) {
+    (void) color;
+}
+
+void gotoxy(uchar x, uchar y) {
+    cursor_x = x; cursor_y = y;
+}
+
+void host_dump_screen(FILE *out) {
+    int x, y;
+    char c;
+
+    for(y = 0; y < SCREEN_HEIGHT; y++) {
+        for(x = 0; x < SCREEN_WIDTH; x++) {
+            c = host_text_screen[y*SCREEN_WIDTH + x];
+            // caractères non imprimables (attributs, damier, fin de chaîne de sprintf...) => '.'
+            fputc((c >= 32 && c < 126) ? c : '.', out);
+        }
+        fputc('\n', out);
+    }
+}
@@ -0,0 +1,461 @@
+/**
+ *      CTextMovingMap - host/prof6502.c
+ *      ================================
+ * 
+ *      Profileur au cycle près: exécute sur PC, dans un coeur 6502 (host/cpu6502.c), le programme
+ *      compilé par OSDK (BUILD/MovingMap.tap) et mesure le nombre exact de cycles:
+ *      - de la phase de démarrage (écran titre + init_map() + display_window() + 1ère frame)
+ *      - de chaque frame de play_map() (une frame = intervalle entre 2 lectures d'un appui de touche
+ *        en 0x208 par input_poll(), voir plus bas)
+ *      - par sous-programme (cumul inclusif / exclusif, nombre d'appels), pour chaque phase
+ *      - par adresse d'instruction (histogramme des adresses "chaudes")
+ * 
+ *      Les routines de la ROM Oric (adresses >= 0xC000) ne sont pas émulées: la ROM est remplie
+ *      d'instructions RTS, un appel ROM coûte donc 6 cycles + le JSR (signalé "[ROM]").
+ *      Le clavier est simulé: un script de déplacements reproductible (même principe que host/bench.c:
+ *      un appui puis un relâchement par pas), puis ESC. Comme sur PC (read_key() / sample_key(),
+ *      voir platform.h), seules les lectures de 0x208 faites par input_poll() (entre 2 frames)
+ *      prennent la touche suivante du script et délimitent les frames; les autres (input_sample(),
+ *      pendant l'affichage) renvoient la touche que lira le prochain input_poll(). input_poll() est
+ *      repéré dans le fichier de symboles (-y); sans ce symbole (programme sans input.c, ou pas de
+ *      symboles), chaque lecture de 0x208 prend la touche suivante. Le compteur système (0x276), décrémenté par l'interruption 100 Hz de la ROM
+ *      sur Oric, est calculé d'après les cycles émulés (1 tic = 10 ms = SYS_TICK_CYCLES cycles à
+ *      1 MHz): wait_vsync() (DOUBLE_BUFFER) attend donc le tic suivant comme sur la machine, et une
+ *      touche du script restée appuyée plus de INPUT_DELAY tics (frame très longue) est répétée.
+ * 
+ *      NB: la carte est générée par le générateur du programme (rnd(), sans appel ROM): elle est
+ *      donc identique à celle du banc de mesure host/bench avec la même graine (MAP_SEED).
+ * 
+ *      Usage: prof6502 [-t fichier.tap] [-y fichier_symboles] [-r nom=debut-fin]... [-n nb_deplacements]
+ *                      [-s graine] [-top nb_lignes] [-c fichier_trace] [-d]
+ *             -y: fichier de symboles (lignes contenant un nom et une adresse, ex. "_main 0x0A3C"
+ *                 ou "0A3C _main"), pour nommer les sous-programmes au lieu de "sub_0A3C" et
+ *                 repérer input_poll()
+ *             -r: plage d'adresses (hexa) dont on veut le total de cycles, ex. pour la boucle
+ *                 d'affichage de la fenêtre: -r blit=137B-13B0 (option répétable)
+ *             -c: enregistre le contenu de l'écran TEXT à chaque lecture du clavier (fin de chaque
+ *                 frame): deux versions du programme (ex. BLIT_ASM ou non) doivent donner des traces
+ *                 identiques octet pour octet pour les mêmes déplacements (voir make asm-check)
+ *             -d: affiche le contenu de l'écran TEXT (0xBB80) à la fin de l'exécution
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "cpu6502.h"
+
+
+/* ================== CONSTANTES ================== */
+
+#define TEXT_SCREEN   0xBB80
+#define SCREEN_WIDTH  40
+#define SCREEN_HEIGHT 28
+#define KEYB_ADDR     0x208
+#define TIMER_ADDR    0x276   // compteur système (octet de poids faible), décrémenté à 100 Hz
+#define SYS_TICK_CYCLES 10000 // cycles d'un tic de ce compteur (10 ms à 1 MHz)
+#define ROM_START     0xC000
+#define EXIT_ADDR     0xFFF0  // adresse de retour "fictive" du programme => fin de l'exécution
+
+#define KEY_LEFT  172
+#define KEY_RIGHT 188
+#define KEY_DOWN  180
+#define KEY_UP    156
+#define KEY_ESC   169
+#define NO_KEY    0x38
+
+#define MAX_CYCLES  4000000000ULL
+#define MAX_DEPTH   64
+#define MAX_SYMBOLS 4096
+#define MAX_RANGES  16
+
+// phases de l'exécution
+#define PHASE_STARTUP 0
+#define PHASE_FRAMES  1
+#define NB_PHASES     2
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+static cpu6502 cpu;
+
+static unsigned long long addr_cycles[NB_PHASES][0x10000];
+static unsigned long long incl_cycles[NB_PHASES][0x10000];
+static unsigned long long excl_cycles[NB_PHASES][0x10000];
+static unsigned long      nb_calls[NB_PHASES][0x10000];
+static byte               is_sub[0x10000];
+
+// pile "fantôme" des appels de sous-programmes (JSR)
+static struct { word target; byte sp; } call_stack[MAX_DEPTH];
+static int depth;
+
+static int phase = PHASE_STARTUP;
+
+// script clavier; adresse de input_poll() (lectures qui avancent dans le script), si connue
+static byte         *keys;
+static unsigned long nb_keys, key_pos;
+static long          poll_addr = -1;
+
+// cycles de chaque frame
+static unsigned long long last_key_cycles, startup_cycles;
+static unsigned long long frame_total, frame_min, frame_max;
+static unsigned long      frames;
+
+// symboles
+static struct { word addr; char name[48]; } symbols[MAX_SYMBOLS];
+static int nb_symbols;
+
+// trace des écrans (option -c)
+static FILE *trace;
+
+// plages d'adresses mesurées (option -r)
+static struct { word first, last; char name[32]; } ranges[MAX_RANGES];
+static int nb_ranges;
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/**
+ * io_read(): lecture du compteur système (0x276) => valeur décrémentée d'un tic toutes les
+ * SYS_TICK_CYCLES cycles depuis le lancement; lecture du clavier (0x208) par input_poll() =>
+ * touche suivante du script, chaque lecture d'un appui termine une frame (ou la phase de démarrage
+ * pour la 1ère lecture); lecture du clavier ailleurs (input_sample()) => même touche, sans avancer
+ */
+static byte io_read(word addr) {
+    unsigned long long dt = cpu.cycles - last_key_cycles;
+    byte key;
+
+    if(addr == TIMER_ADDR) return (byte) -(long long) (cpu.cycles / SYS_TICK_CYCLES);
+    if(poll_addr >= 0 && call_stack[depth-1].target != poll_addr) {
+        return key_pos < nb_keys ? keys[key_pos] : KEY_ESC;
+    }
+    key = key_pos < nb_keys ? keys[key_pos++] : KEY_ESC;
+    if(trace != NULL) fwrite(&cpu.mem[TEXT_SCREEN], 1, SCREEN_WIDTH*SCREEN_HEIGHT, trace);
+    if(phase == PHASE_STARTUP) {
+        startup_cycles = cpu.cycles;
+        phase = PHASE_FRAMES;
+    }
+    else if(key == NO_KEY) {
+        return key; // relâchement: la frame continue
+    }
+    else {
+        frames++;
+        frame_total += dt;
+        if(frames == 1 || dt < frame_min) frame_min = dt;
+        if(dt > frame_max) frame_max = dt;
+    }
+    last_key_cycles = cpu.cycles;
+    return key;
+}
+
+/**
+ * make_moves(): même suite de déplacements que host/bench.c (2*count touches: appui, relâchement)
+ */
+static byte *make_moves(unsigned long count, unsigned long seed) {
+    static const byte dirs[4] = { KEY_LEFT, KEY_RIGHT, KEY_UP, KEY_DOWN };
+    byte *k = malloc(count ? 2*count : 1);
+    unsigned long i = 0, run;
+    byte key;
+
+    while(i < 2*count) {
+        seed = seed * 1103515245UL + 12345UL;
+        key = dirs[(seed >> 16) & 3];
+        run = 1 + ((seed >> 20) & 7);
+        for(; run > 0 && i < 2*count; run--) {
+            k[i++] = key;
+            k[i++] = NO_KEY;
+        }
+    }
+    return k;
+}
+
+/**
+ * load_tap(): charge un fichier .tap Oric (en-tête: octets de synchro 0x16, 0x24, 9 octets
+ * d'en-tête dont adresses de fin/début, nom terminé par 0, puis les données) en mémoire.
+ * Renvoie l'adresse de début, ou -1 en cas d'erreur.
+ */
+static long load_tap(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    int c;
+    byte header[9];
+    unsigned int start, end;
+
+    if(f == NULL) { perror(filename); return -1; }
+    while((c = fgetc(f)) == 0x16) ;
+    if(c != 0x24 || fread(header, 1, 9, f) != 9) {
+        fprintf(stderr, "%s: en-tete .tap invalide\n", filename);
+        fclose(f);
+        return -1;
+    }
+    end   = (header[4] << 8) | header[5];
+    start = (header[6] << 8) | header[7];
+    while((c = fgetc(f)) != 0 && c != EOF) ;  // nom du programme
+    if(end < start || fread(&cpu.mem[start], 1, end - start + 1, f) != end - start + 1) {
+        fprintf(stderr, "%s: donnees .tap tronquees\n", filename);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+    return (long) start;
+}
+
+static void load_symbols(const char *filename) {
+    FILE *f = fopen(filename, "r");
+    char line[256], *tok, *name;
+    long addr;
+
+    if(f == NULL) { perror(filename); return; }
+    while(fgets(line, sizeof(line), f) != NULL && nb_symbols < MAX_SYMBOLS) {
+        name = NULL; addr = -1;
+        for(tok = strtok(line, " \t,;=\r\n"); tok != NULL; tok = strtok(NULL, " \t,;=\r\n")) {
+            char *p = tok, *endp;
+            if(*p == '$') p++;
+            else if(p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) p += 2;
+            if(addr < 0 && strlen(p) == 4 && isxdigit((unsigned char) *p)) {
+                long v = strtol(p, &endp, 16);
+                if(*endp == '\0') { addr = v; continue; }
+            }
+            if(name == NULL && (isalpha((unsigned char) *tok) || *tok == '_')) name = tok;
+        }
+        if(name != NULL && addr >= 0) {
+            symbols[nb_symbols].addr = (word) addr;
+            strncpy(symbols[nb_symbols].name, name, sizeof(symbols[0].name) - 1);
+            nb_symbols++;
+        }
+    }
+    fclose(f);
+}
+
+/**
+ * add_range(): option -r nom=debut-fin (adresses en hexa)
+ */
+static int add_range(const char *arg) {
+    const char *eq = strchr(arg, '=');
+    unsigned int first, last;
+
+    if(eq == NULL || nb_ranges >= MAX_RANGES || sscanf(eq + 1, "%x-%x", &first, &last) != 2
+       || first > last || first > 0xFFFF || last > 0xFFFF) {
+        fprintf(stderr, "plage invalide: %s (attendu: nom=debut-fin)\n", arg);
+        return -1;
+    }
+    ranges[nb_ranges].first = (word) first;
+    ranges[nb_ranges].last  = (word) last;
+    snprintf(ranges[nb_ranges].name, sizeof(ranges[0].name), "%.*s", (int) (eq - arg), arg);
+    nb_ranges++;
+    return 0;
+}
+
+/**
+ * symbol_name(): nom "symbole+décalage" de l'adresse (symbole le plus proche en dessous)
+ */
+static const char *symbol_name(word addr) {
+    static char buffer[64];
+    int i, best = -1;
+
+    if(addr >= ROM_START) { sprintf(buffer, "[ROM] %04X", addr); return buffer; }
+    for(i = 0; i < nb_symbols; i++) {
+        if(symbols[i].addr <= addr && (best < 0 || symbols[i].addr > symbols[best].addr)) best = i;
+    }
+    if(best < 0) {
+        // pas de symbole: sous-programme (cible de JSR) le plus proche en dessous
+        long a;
+        for(a = addr; a >= 0 && !is_sub[a]; a--) ;
+        if(a < 0 || a == addr) sprintf(buffer, "sub_%04X", addr);
+        else sprintf(buffer, "sub_%04X+%ld", (unsigned int) a, (long) addr - a);
+    }
+    else if(symbols[best].addr == addr) sprintf(buffer, "%s", symbols[best].name);
+    else sprintf(buffer, "%s+%d", symbols[best].name, addr - symbols[best].addr);
+    return buffer;
+}
+
+/**
+ * run(): exécution jusqu'au retour du programme (EXIT_ADDR), avec comptage des cycles
+ */
+static int run(word start) {
+    word pc, target;
+    byte op;
+    int  n, i, j;
+
+    // adresse de retour fictive: le RTS final du programme revient en EXIT_ADDR
+    cpu_reset(&cpu, start);
+    cpu.mem[0x100 | cpu.sp--] = (byte) ((EXIT_ADDR - 1) >> 8);
+    cpu.mem[0x100 | cpu.sp--] = (byte) (EXIT_ADDR - 1);
+    depth = 0;
+    call_stack[depth].target = start; call_stack[depth].sp = cpu.sp; depth++;
+    is_sub[start] = 1;
+
+    while(cpu.pc != EXIT_ADDR) {
+        if(cpu.cycles > MAX_CYCLES) {
+            fprintf(stderr, "arret: plus de %llu cycles\n", MAX_CYCLES);
+            return -1;
+        }
+        pc = cpu.pc;
+        op = cpu.mem[pc];
+        n = cpu_step(&cpu);
+        if(n == 0 || op == 0x00) {
+            fprintf(stderr, "arret: opcode %02X (illegal ou BRK) en %04X\n", op, pc);
+            return -1;
+        }
+
+        addr_cycles[phase][pc] += n;
+        excl_cycles[phase][call_stack[depth-1].target] += n;
+        for(i = 0; i < depth; i++) {
+            // récursion: ne compter qu'une fois chaque sous-programme présent dans la pile
+            for(j = 0; j < i && call_stack[j].target != call_stack[i].target; j++) ;
+            if(j == i) incl_cycles[phase][call_stack[i].target] += n;
+        }
+
+        if(op == 0x20 && depth < MAX_DEPTH) {
+            target = cpu.pc;
+            call_stack[depth].target = target; call_stack[depth].sp = cpu.sp; depth++;
+            nb_calls[phase][target]++;
+            is_sub[target] = 1;
+        }
+        else if(op == 0x60 || op == 0x40) {
+            while(depth > 1 && cpu.sp > call_stack[depth-1].sp) depth--;
+        }
+    }
+    return 0;
+}
+
+static int compare_incl_phase;
+
+static int compare_incl(const void *a, const void *b) {
+    unsigned long long va = incl_cycles[compare_incl_phase][*(const word *) a];
+    unsigned long long vb = incl_cycles[compare_incl_phase][*(const word *) b];
+    return va < vb ? 1 : va > vb ? -1 : 0;
+}
+
+static int compare_addr_phase;
+
+static int compare_addr(const void *a, const void *b) {
+    unsigned long long va = addr_cycles[compare_addr_phase][*(const word *) a];
+    unsigned long long vb = addr_cycles[compare_addr_phase][*(const word *) b];
+    return va < vb ? 1 : va > vb ? -1 : 0;
+}
+
+/**
+ * report_phase(): cycles par sous-programme puis histogramme des adresses chaudes d'une phase
+ * (pour la phase des frames, les valeurs sont aussi données par frame)
+ */
+static void report_phase(int ph, const char *title, unsigned long divisor, int top) {
+    static word list[0x10000];
+    int i, n = 0;
+    unsigned long long total = 0;
+
+    for(i = 0; i < 0x10000; i++) total += addr_cycles[ph][i];
+    printf("\n==== %s: %llu cycles ====\n", title, total);
+    if(total == 0) return;
+
+    printf("%-28s %10s %14s %14s %12s\n", "sous-programme", "appels", "inclusif", "exclusif",
+           divisor > 1 ? "incl/frame" : "incl/appel");
+    for(i = 0; i < 0x10000; i++) if(is_sub[i] && incl_cycles[ph][i] > 0) list[n++] = (word) i;
+    compare_incl_phase = ph;
+    qsort(list, n, sizeof(word), compare_incl);
+    for(i = 0; i < n && i < top; i++) {
+        word a = list[i];
+        unsigned long calls = nb_calls[ph][a];
+        printf("%-28s %10lu %14llu %14llu %12.1f\n", symbol_name(a), calls,
+               incl_cycles[ph][a], excl_cycles[ph][a],
+               divisor > 1 ? (double) incl_cycles[ph][a] / divisor
+                           : (double) incl_cycles[ph][a] / (calls ? calls : 1));
+    }
+
+    for(i = 0; i < nb_ranges; i++) {
+        unsigned long long sum = 0;
+        long a;
+        if(i == 0) printf("\n%-28s %10s %14s %12s\n", "plage", "", "cycles", "par frame");
+        for(a = ranges[i].first; a <= ranges[i].last; a++) sum += addr_cycles[ph][a];
+        printf("%-28s %10s %14llu %12.1f\n", ranges[i].name, "", sum,
+               (double) sum / (divisor ? divisor : 1));
+    }
+
+    printf("\n%-28s %6s %14s %7s\n", "adresse chaude", "", "cycles", "%");
+    n = 0;
+    for(i = 0; i < 0x10000; i++) if(addr_cycles[ph][i] > 0) list[n++] = (word) i;
+    compare_addr_phase = ph;
+    qsort(list, n, sizeof(word), compare_addr);
+    for(i = 0; i < n && i < top; i++) {
+        word a = list[i];
+        printf("%04X %-23s %6s %14llu %6.2f%%\n", a, symbol_name(a), "",
+               addr_cycles[ph][a], 100.0 * addr_cycles[ph][a] / total);
+    }
+}
+
+static void dump_screen() {
+    int x, y;
+    byte c;
+
+    for(y = 0; y < SCREEN_HEIGHT; y++) {
+        for(x = 0; x < SCREEN_WIDTH; x++) {
+            c = cpu.mem[TEXT_SCREEN + y*SCREEN_WIDTH + x];
+            putchar((c >= 32 && c < 126) ? c : '.');
+        }
+        putchar('\n');
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *tap = "BUILD/MovingMap.tap", *symfile = NULL, *tracefile = NULL;
+    unsigned long moves = 1000, seed = 1;
+    int top = 20, dump = 0, i;
+    long start;
+
+    for(i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-t") == 0 && i+1 < argc) tap = argv[++i];
+        else if(strcmp(argv[i], "-y") == 0 && i+1 < argc) symfile = argv[++i];
+        else if(strcmp(argv[i], "-r") == 0 && i+1 < argc) { if(add_range(argv[++i]) != 0) return 2; }
+        else if(strcmp(argv[i], "-n") == 0 && i+1 < argc) moves = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "-s") == 0 && i+1 < argc) seed = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "-top") == 0 && i+1 < argc) top = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-c") == 0 && i+1 < argc) tracefile = argv[++i];
+        else if(strcmp(argv[i], "-d") == 0) dump = 1;
+        else {
+            fprintf(stderr, "usage: %s [-t file.tap] [-y symbols] [-r name=first-last] [-n moves] [-s seed] [-top N] [-c trace] [-d]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    // ROM non émulée: remplie de RTS; les vecteurs de la page 2 (0x238 à 0x24F: sortie/entrée
+    // de caractère, IRQ, NMI...), normalement initialisés par la ROM, pointent sur cette ROM "vide"
+    memset(&cpu.mem[ROM_START], 0x60, 0x10000 - ROM_START);
+    for(i = 0x238; i < 0x250; i += 3) {
+        cpu.mem[i] = 0x4C; cpu.mem[i+1] = (byte) ROM_START; cpu.mem[i+2] = (byte) (ROM_START >> 8);
+    }
+    start = load_tap(tap);
+    if(start < 0) return 1;
+    if(symfile != NULL) load_symbols(symfile);
+    for(i = 0; i < nb_symbols; i++) {
+        if(strcmp(symbols[i].name, "_input_poll") == 0 || strcmp(symbols[i].name, "input_poll") == 0) {
+            poll_addr = symbols[i].addr;
+        }
+    }
+
+    keys = make_moves(moves, seed);
+    nb_keys = 2*moves;
+    cpu.io[KEYB_ADDR] = 1;
+    cpu.io[TIMER_ADDR] = 1;
+    cpu.io_read = io_read;
+
+    if(tracefile != NULL) {
+        trace = fopen(tracefile, "wb");
+        if(trace == NULL) { perror(tracefile); return 1; }
+    }
+    if(run((word) start) != 0) return 1;
+    if(trace != NULL) fclose(trace);
+
+    if(dump) dump_screen();
+    printf("programme:          %s (debut %04X)\n", tap, (unsigned int) start);
+    printf("deplacements:       %lu (graine %lu)\n", moves, seed);
+    printf("demarrage:          %llu cycles (titre + init_map + 1ere frame)\n", startup_cycles);
+    if(frames > 0) {
+        printf("frames:             %lu\n", frames);
+        printf("cycles/frame:       moy %.0f  min %llu  max %llu\n",
+               (double) frame_total / frames, frame_min, frame_max);
+    }
+    report_phase(PHASE_STARTUP, "demarrage", 1, top);
+    report_phase(PHASE_FRAMES, "frames de play_map()", frames, top);
+    free(keys);
+    return 0;
+}
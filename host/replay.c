@@ -0,0 +1,251 @@
+/**
+ *      CTextMovingMap - host/replay.c
+ *      ==============================
+ *
+ *      Enregistrement et rejeu de traces de parties (INPUT_TRACE, voir trace.c), avec les options
+ *      de compilation du moteur (DEFS):
+ *      - replay -r trace: joue une partie "scriptée" (séries de pas, appuis/relâchements ou touche
+ *        tenue avec répétition) sur la carte de la graine -s, et l'enregistre dans le fichier trace,
+ *        avec une somme de contrôle de la fenêtre toutes les -c frames
+ *      - replay trace...: rejoue chaque trace (même carte, mêmes événements à chaque frame) et
+ *        compare les sommes de contrôle de la fenêtre à celles de l'enregistrement; le temps moyen
+ *        par frame mesure une charge identique d'une version du moteur à l'autre.
+ *        Code de retour 1 si une trace rejouée diffère de son enregistrement
+ *
+ *      Usage: replay -r trace [-n nb_deplacements] [-s graine] [-c frames] [-w monde] [-m niveau]
+ *             replay [-w monde] [-m niveau] trace...
+ *             -m: avec MAP_FILE, niveau chargé à la place de la carte générée (à redonner au rejeu:
+ *                 la trace ne contient que la graine)
+ *
+ *      Format du fichier (entiers 16 bits, poids faible en premier): en-tête de TRACE_HEADER_SIZE
+ *      octets ("MMT1", graine, frames entre 2 sommes, WIN_XSIZE, WIN_YSIZE, nombre d'octets
+ *      d'événements, nombre de sommes), puis les événements (trace_data[]) et les sommes de contrôle
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "host_platform.h"
+
+
+/* ================== CONSTANTES ================== */
+
+#define TRACE_HEADER_SIZE 16
+
+
+/* ================== MACROS ================== */
+
+#define get16(addr)       ((addr)[0] | ((unsigned int) (addr)[1] << 8))
+#define put16(addr, v)    { (addr)[0] = (uchar) (v); (addr)[1] = (uchar) ((v) >> 8); }
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// niveau chargé à la place de la carte générée (-m, MAP_FILE)
+static const char *level;
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+static unsigned long long now_ns() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long) ts.tv_sec * 1000000000ULL + (unsigned long long) ts.tv_nsec;
+}
+
+/**
+ * make_script(count, seed, &length): suite reproductible de lectures du clavier, par séries de 1 à
+ * 8 pas dans une même direction: un appui et un relâchement par pas, ou la touche tenue le temps
+ * des répétitions (voir input.c); avec PATHFIND, de temps en temps ESPACE (retour au départ)
+ */
+static uchar *make_script(unsigned long count, unsigned long seed, unsigned long *length) {
+    static const uchar dirs[4] = { KEY_LEFT, KEY_RIGHT, KEY_UP, KEY_DOWN };
+    unsigned long size = count * (2 + INPUT_DELAY + INPUT_REPEAT) + 1000;
+    uchar *k = malloc(size);
+    unsigned long i = 0, steps = 0, run, n;
+    uchar key;
+
+    while(steps < count && i + 2*(INPUT_DELAY + 8*INPUT_REPEAT) + 600 < size) {
+        seed = seed * 1103515245UL + 12345UL;
+        key = dirs[(seed >> 16) & 3];
+        run = 1 + ((seed >> 20) & 7);
+#ifdef PATHFIND
+        if(((seed >> 24) & 31) == 0) {
+            // retour au départ: le voyage se poursuit tant qu'aucune touche n'est lue
+            k[i++] = KEY_SPACE;
+            for(n = 0; n < 500; n++) k[i++] = NO_KEY;
+            continue;
+        }
+#endif
+        if((seed >> 23) & 1) {
+            // touche tenue: 1er pas, puis un pas par répétition
+            for(n = 0; n < INPUT_DELAY + (run-1)*INPUT_REPEAT; n++) k[i++] = key;
+            k[i++] = NO_KEY;
+        }
+        else {
+            for(n = 0; n < run; n++) {
+                k[i++] = key;
+                k[i++] = NO_KEY;
+            }
+        }
+        steps += run;
+    }
+    *length = i;
+    return k;
+}
+
+/**
+ * new_game(seed): carte de la graine seed (ou niveau -m) et fenêtre, comme le programme Oric;
+ * FALSE si le niveau ne peut être chargé
+ */
+static bool new_game(unsigned int seed) {
+#ifdef MAP_FILE
+    map_info info;
+#endif
+
+    rnd_seed(seed);
+    cls();
+    init_map();
+#ifdef MAP_FILE
+    if(level != NULL && !map_file_load(STORE_DATA, &info)) {
+        fprintf(stderr, "%s: carte illisible\n", level);
+        return FALSE;
+    }
+#endif
+#ifdef MINIMAP
+    minimap_build();
+#endif
+    cls();
+    display_window();
+    return TRUE;
+}
+
+/**
+ * record(filename, moves, seed): enregistrement d'une partie scriptée
+ */
+static int record(const char *filename, unsigned long moves, unsigned long seed) {
+    uchar header[TRACE_HEADER_SIZE], entry[2];
+    unsigned long length;
+    uchar *keys = make_script(moves, seed, &length);
+    unsigned int k;
+    FILE *f;
+
+    if(!new_game((unsigned int) seed)) return 1;
+    trace_seed = (unsigned int) seed;
+    trace_start(TRACE_RECORD);
+    host_set_keys(keys, length);
+    play_map();
+    trace_mode = TRACE_OFF;
+    free(keys);
+    if(trace_full) fprintf(stderr, "%s: trace tronquee (%d octets)\n", filename, TRACE_MAX_EVENTS);
+
+    f = fopen(filename, "wb");
+    if(f == NULL) { perror(filename); return 1; }
+    memset(header, 0, sizeof(header));
+    memcpy(header, "MMT1", 4);
+    put16(header + 4, trace_seed);
+    put16(header + 6, trace_every);
+    put16(header + 8, WIN_XSIZE);
+    put16(header + 10, WIN_YSIZE);
+    put16(header + 12, trace_length);
+    put16(header + 14, trace_nb_sums);
+    fwrite(header, 1, sizeof(header), f);
+    fwrite(trace_data, 1, trace_length, f);
+    for(k = 0; k < trace_nb_sums; k++) {
+        put16(entry, trace_sums[k]);
+        fwrite(entry, 1, 2, f);
+    }
+    fclose(f);
+    fprintf(stdout, "%s: %u frames, %u octets d'evenements, %u sommes de controle\n",
+            filename, trace_frames, trace_length, trace_nb_sums);
+    return 0;
+}
+
+/**
+ * replay(filename): rejeu d'une trace; 1 si elle ne peut être lue ou si une somme diffère
+ */
+static int replay(const char *filename) {
+    uchar header[TRACE_HEADER_SIZE], entry[2];
+    unsigned long long t0, ns;
+    unsigned int k;
+    FILE *f = fopen(filename, "rb");
+
+    if(f == NULL) { perror(filename); return 1; }
+    if(fread(header, 1, sizeof(header), f) != sizeof(header) || memcmp(header, "MMT1", 4) != 0) {
+        fprintf(stderr, "%s: pas une trace\n", filename);
+        fclose(f);
+        return 1;
+    }
+    if(get16(header + 8) != WIN_XSIZE || get16(header + 10) != WIN_YSIZE
+    || get16(header + 12) > TRACE_MAX_EVENTS || get16(header + 14) > TRACE_MAX_SUMS
+    || get16(header + 6) == 0) {
+        fprintf(stderr, "%s: fenetre %ux%u ou taille incompatible\n", filename,
+                get16(header + 8), get16(header + 10));
+        fclose(f);
+        return 1;
+    }
+    trace_seed = get16(header + 4);
+    trace_every = (uchar) get16(header + 6);
+    trace_length = get16(header + 12);
+    trace_nb_sums = get16(header + 14);
+    if(fread(trace_data, 1, trace_length, f) != trace_length) trace_length = 0;
+    for(k = 0; k < trace_nb_sums; k++) {
+        if(fread(entry, 1, 2, f) != 2) break;
+        trace_sums[k] = get16(entry);
+    }
+    fclose(f);
+    if(k < trace_nb_sums || trace_length == 0) {
+        fprintf(stderr, "%s: trace incomplete\n", filename);
+        return 1;
+    }
+
+    if(!new_game(trace_seed)) return 1;
+    trace_start(TRACE_REPLAY);
+    host_set_keys(NULL, 0);
+    t0 = now_ns();
+    play_map();
+    ns = now_ns() - t0;
+    trace_mode = TRACE_OFF;
+
+    fprintf(stdout, "%s: %u frames, %.0f ns/frame, ", filename, trace_frames,
+            (double) ns / (trace_frames ? trace_frames : 1));
+    if(trace_errors == 0) {
+        fprintf(stdout, "OK (%u sommes)\n", trace_nb_sums);
+        return 0;
+    }
+    fprintf(stdout, "ECHEC: %u sommes differentes, 1ere a la frame %u\n", trace_errors, trace_error_frame);
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned long moves = 2000, seed = 1, every = TRACE_EVERY;
+    const char *output = NULL;
+    int i, status = 0, nb_traces = 0;
+
+    for(i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-r") == 0 && i+1 < argc) output = argv[++i];
+        else if(strcmp(argv[i], "-n") == 0 && i+1 < argc) moves = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "-s") == 0 && i+1 < argc) seed = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "-c") == 0 && i+1 < argc) every = strtoul(argv[++i], NULL, 0);
+        else if(strcmp(argv[i], "-w") == 0 && i+1 < argc) host_store_file = argv[++i];
+        else if(strcmp(argv[i], "-m") == 0 && i+1 < argc) host_store_file = level = argv[++i];
+        else if(argv[i][0] != '-') nb_traces++;
+        else break;
+    }
+    if(i < argc || (output == NULL) == (nb_traces == 0) || every == 0 || every > 255) {
+        fprintf(stderr, "usage: %s -r trace [-n moves] [-s seed] [-c frames] [-w world] [-m level]\n"
+                        "       %s [-w world] [-m level] trace...\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    if(output != NULL) {
+        trace_every = (uchar) every;
+        return record(output, moves, seed);
+    }
+    for(i = 1; i < argc; i++) {
+        if(argv[i][0] == '-') { i++; continue; }
+        if(replay(argv[i]) != 0) status = 1;
+    }
+    return status;
+}
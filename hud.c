@@ -0,0 +1,102 @@
+/**
+ *      CTextMovingMap - hud.c
+ *      ======================
+ * 
+ *      Lignes d'infos (coordonnées du personnage) au-dessus de la fenêtre, à champs numériques fixes:
+ * 
+ *          X=ddd PX=ddd Y=ddd PY=ddd
+ *          XV=ddd YV=ddd
+ * 
+ *      (les coordonnées dans la carte occupent HUD_COORD_WIDTH chiffres: 3, ou 5 en mode MAP_TILED / MAP_RLE)
+ * 
+ *      Les libellés ne sont écrits qu'une fois (hud_init()); ensuite, un champ n'est réécrit que si
+ *      sa valeur a changé depuis la frame précédente (macro hud_update()), avec une conversion
+ *      décimale par soustractions successives au lieu de sprintf().
+ */
+
+#include "movingmap.h"
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// libellé, largeur (nombre de chiffres) et ligne (0 ou 1) de chaque champ
+static char *hud_labels[HUD_NB_FIELDS] = { "X=", "PX=", "Y=", "PY=", "XV=", "YV=" };
+static uchar hud_widths[HUD_NB_FIELDS] = {
+    HUD_COORD_WIDTH, 3, HUD_COORD_WIDTH, 3, HUD_COORD_WIDTH, HUD_COORD_WIDTH
+};
+static uchar hud_lines[HUD_NB_FIELDS]  = { 0, 0, 0, 0, 1, 1 };
+
+// puissances de 10 utilisées pour la conversion décimale (selon la taille du type coord)
+#if HUD_COORD_WIDTH > 3
+static coord hud_pow10[] = { 10000, 1000, 100, 10 };
+#else
+static coord hud_pow10[] = { 100, 10 };
+#endif
+#define HUD_NB_POW10 (sizeof(hud_pow10)/sizeof(hud_pow10[0]))
+
+// adresse écran (ou tampon) du 1er chiffre de chaque champ, calculée par hud_init()
+static char *hud_addrs[HUD_NB_FIELDS];
+
+// dernière valeur affichée de chaque champ
+coord hud_values[HUD_NB_FIELDS];
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/** 
+ * hud_init(): affichage des libellés; tous les champs sont initialisés à la valeur 0
+ */
+void hud_init() {
+    uchar i, j;
+    char *addr = ADDR_INFOLINE1;
+    char *label;
+
+    for(i=0; i < HUD_NB_FIELDS; i++) {
+        if(i > 0 && hud_lines[i] != hud_lines[i-1]) {
+            // fin de la ligne précédente, puis passage à la 2e ligne d'infos
+            *addr++ = ' ';
+            count_writes(1);
+            addr = ADDR_INFOLINE2;
+        }
+        for(label = hud_labels[i]; *label != '\0'; label++) {
+            *addr++ = *label;
+        }
+        hud_addrs[i] = addr;
+        hud_values[i] = 0;
+        *addr++ = '0';
+        for(j=1; j <= hud_widths[i]; j++) {
+            *addr++ = ' '; // chiffres suivants + séparateur
+        }
+        count_writes(label - hud_labels[i] + 1 + hud_widths[i]);
+    }
+    *addr = ' ';
+    count_writes(1);
+}
+
+/** 
+ * hud_draw_field(field, value): affichage de la valeur d'un champ (cadrée à gauche et complétée par
+ * des espaces, comme le faisait le "%d" de sprintf())
+ */
+void hud_draw_field(uchar field, coord value) {
+    char *addr = hud_addrs[field];
+    char *end  = addr + hud_widths[field];
+    bool started = FALSE;
+    uchar i;
+    char digit;
+
+    hud_values[field] = value;
+
+    for(i=0; i < HUD_NB_POW10; i++) {
+        for(digit = '0'; value >= hud_pow10[i]; digit++) value -= hud_pow10[i];
+        if(digit != '0' || started) {
+            *addr++ = digit;
+            started = TRUE;
+        }
+    }
+    *addr++ = '0' + value;
+
+    while(addr < end) {
+        *addr++ = ' ';
+    }
+    count_writes(addr - hud_addrs[field]);
+}
@@ -0,0 +1,149 @@
+/**
+ *      CTextMovingMap - input.c
+ *      ========================
+ *
+ *      Clavier: file circulaire d'événements (touches valides: flèches, ESC, et ESPACE avec PATHFIND)
+ *      alimentée par les échantillonnages de l'octet de la dernière touche pressée: input_poll()
+ *      entre 2 frames, et input_sample() aux limites des étapes de l'affichage (après chaque
+ *      fenêtre, après le personnage, après les infos), pour qu'une touche pressée puis relâchée
+ *      pendant l'affichage d'une frame soit vue. Une touche pressée et relâchée entre 2
+ *      échantillonnages (pendant une seule étape longue, ex. un affichage complet) est perdue.
+ *      - une touche n'est prise en compte qu'à l'appui (changement de valeur): tant qu'elle reste
+ *        enfoncée, elle ne produit pas d'autre événement (anti-rebond), hormis la répétition
+ *      - répétition: 1er événement répété après INPUT_DELAY tics du compteur système, puis un
+ *        tous les INPUT_REPEAT tics. Les répétitions "manquées" entre 2 échantillonnages sont
+ *        rattrapées d'un coup au suivant: la vitesse de déplacement ne dépend plus de la durée
+ *        d'une frame, play_map() applique tous les pas en attente avant un seul affichage
+ *      Si la file est pleine, les nouveaux événements sont perdus.
+ *      Avec INPUT_TRACE, les événements renvoyés sont enregistrés dans la trace, ou lus dans la trace
+ *      au lieu du clavier en rejeu (voir trace.c).
+ */
+
+#include "movingmap.h"
+
+#if (INPUT_QUEUE_SIZE & (INPUT_QUEUE_SIZE-1)) != 0
+#error "INPUT_QUEUE_SIZE doit etre une puissance de 2"
+#endif
+#if INPUT_REPEAT == 0
+#error "INPUT_REPEAT doit etre non nul"
+#endif
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// file des événements: de input_head (le plus ancien) à input_tail exclu
+static uchar input_queue[INPUT_QUEUE_SIZE];
+static uchar input_head = 0, input_tail = 0;
+
+// touche lue au dernier échantillonnage, date (compteur système) de son dernier événement et
+// nombre de tics avant l'événement répété suivant
+static uchar input_held = NO_KEY;
+static uchar input_t0, input_ticks;
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/**
+ * input_valid(key): touche utilisée par play_map()
+ */
+static bool input_valid(uchar key) {
+    return key == KEY_LEFT || key == KEY_RIGHT || key == KEY_UP || key == KEY_DOWN
+        || key == KEY_ESC
+#ifdef PATHFIND
+        || key == KEY_SPACE // retour au point de départ (voir play_map())
+#endif
+        ;
+}
+
+/**
+ * input_push(key): ajout d'un événement à la file (perdu si elle est pleine)
+ */
+static void input_push(uchar key) {
+    uchar tail = (input_tail + 1) & (INPUT_QUEUE_SIZE-1);
+
+    if(tail == input_head) return;
+    input_queue[input_tail] = key;
+    input_tail = tail;
+}
+
+/**
+ * input_feed(key): touche key lue à un échantillonnage => 0, 1 ou plusieurs événements dans la file
+ * (le compteur système est décrémenté: temps écoulé = input_t0 - now, modulo 256)
+ */
+static void input_feed(uchar key) {
+    uchar now = SYS_TIMER_LO;
+
+    if(key != input_held) {
+        // appui (ou relâchement): un seul événement, répétition après INPUT_DELAY tics
+        input_held = key;
+        if(input_valid(key)) {
+            input_push(key);
+            input_t0 = now;
+            input_ticks = INPUT_DELAY;
+        }
+    }
+    else if(input_valid(key)) {
+        // touche tenue: un événement par période écoulée depuis le dernier
+        while((uchar) (input_t0 - now) >= input_ticks) {
+            input_push(key);
+            input_t0 -= input_ticks;
+            input_ticks = INPUT_REPEAT;
+        }
+    }
+}
+
+/**
+ * input_poll(): un échantillonnage du clavier entre 2 frames
+ */
+void input_poll() {
+#ifdef INPUT_TRACE
+    if(trace_mode == TRACE_REPLAY) return;
+#endif
+    input_feed(read_key());
+}
+
+/**
+ * input_sample(): un échantillonnage du clavier pendant l'affichage d'une frame (les événements
+ * restent dans la file jusqu'à la gestion du clavier de play_map())
+ */
+void input_sample() {
+#ifdef INPUT_TRACE
+    if(trace_mode == TRACE_REPLAY) return;
+#endif
+    input_feed(sample_key());
+}
+
+/**
+ * input_next(): événement le plus ancien de la file, NO_KEY si elle est vide (sans attente)
+ */
+uchar input_next() {
+    uchar key;
+
+#ifdef INPUT_TRACE
+    if(trace_mode == TRACE_REPLAY) return trace_get(FALSE);
+#endif
+    if(input_head == input_tail) return NO_KEY;
+    key = input_queue[input_head];
+    input_head = (input_head + 1) & (INPUT_QUEUE_SIZE-1);
+#ifdef INPUT_TRACE
+    if(trace_mode == TRACE_RECORD) trace_put(key);
+#endif
+    return key;
+}
+
+/**
+ * input_wait(): prochain événement, en scannant le clavier jusqu'à ce qu'il y en ait un (au moins
+ * un échantillonnage, même si l'affichage a déjà rempli la file)
+ */
+uchar input_wait() {
+    uchar key;
+
+#ifdef INPUT_TRACE
+    if(trace_mode == TRACE_REPLAY) return trace_get(TRUE);
+#endif
+    input_poll();
+    while((key = input_next()) == NO_KEY) {
+        input_poll();
+    }
+    return key;
+}
@@ -27,146 +27,61 @@
  *  = - quartet inférieur (bits 0 à 3) = cellule de n° impair
  *  =
  *  =========================================================================================================
+ * 
+ *      v1.3    - affichage incrémental: seules les cases modifiées sont redessinées quand la partie
+ *                visible ne bouge pas; sinon décalage du contenu de la fenêtre en mémoire écran et
+ *                décodage de la seule ligne/colonne nouvellement visible
+ *      v1.4    - découpage en modules (map.c, render.c, play.c) et couche plateforme (platform.h):
+ *                le moteur peut aussi être compilé sur PC (gcc, écran TEXT simulé en RAM, clavier
+ *                "scripté") => banc de mesure des performances (make bench)
+ *      v1.5    - affichage par paires de cellules: tables de décodage octet => 2 caractères, construites
+ *                à partir de c_values[] (plus de test de parité pour chaque case)
+ *      v1.6    - option DOUBLE_BUFFER: frame composée hors écran puis recopiée d'un bloc
+ *      v1.7    - lignes d'infos sans sprintf() à chaque frame: champs numériques fixes, réaffichés
+ *                uniquement quand leur valeur change (hud.c)
+ *      v1.8    - option MAP_TILED: monde plus grand que la RAM, découpé en tuiles lues à la demande
+ *                sur un support externe avec cache LRU (tiles.c), coordonnées sur 16 bits
+ *      v1.9    - option MAP_RLE: carte 320x320 compressée par suites de cellules identiques (rle.c),
+ *                affichée et testée directement sous forme compressée
+ *      v1.10   - générateur pseudo-aléatoire xorshift 16 bits avec graine (MAP_SEED: carte reproductible),
+ *                sans division; init_map() par passes de tirages groupés, sans message d'attente
+ *      v1.11   - option MAP_LAZY: carte générée par régions de 16x16 à leur premier affichage ou test
+ *                de collision, à partir de la graine et des coordonnées de la région
+ *      v1.12   - option BLIT_GEN: routines d'affichage déroulées générées pour la géométrie de la
+ *                fenêtre (host/mkblit => blit_gen.c), variantes xv pair / impair
+ *      v1.13   - option BLIT_ASM: affichage d'une ligne de la fenêtre et test des 4 déplacements
+ *                possibles en assembleur 6502 (blit.s), pointeurs en page zéro
+ *      v1.14   - moteur d'affichage par fenêtres indépendantes (viewports) qui suivent chacune un
+ *                personnage, lignes communes recopiées entre fenêtres; option VIEW_SPLIT (2 fenêtres)
+ *      v1.15   - option MINIMAP: mini-carte du terrain dominant par bloc de 8x8, comptes par bloc
+ *                tenus à jour par set_map_cell(), seul le marqueur du personnage est redessiné
+ *      v1.16   - plan de praticabilité (1 bit par cellule) pour les tests de collision, classes de
+ *                terrain praticables configurables (PASSABLE_VALUES)
+ *      v1.17   - option PATHFIND: parcours en largeur et A* incrémentaux (budget par appel), mémoire
+ *                bornée (bits par cellule, file à 2 compartiments); ESPACE = retour au départ
+ *      v1.18   - option ENTITIES: entités rangées par attribut et par bandes de lignes, seules les
+ *                cases modifiées et la partie nouvellement décodée des fenêtres sont redessinées
+ *      v1.19   - clavier par file d'événements (input.c): anti-rebond, répétition réglable
+ *                (INPUT_DELAY, INPUT_REPEAT), déplacements en attente appliqués avant un seul affichage
+ *      v1.20   - option FOG: champ de vision par lignes de visée précalculées (terrains opaques
+ *                OPAQUE_VALUES), plan des cases explorées testé pendant le décodage de la carte
+ *      v1.21   - option MAP_FILE: carte chargée au démarrage (fichier binaire versionné, index des
+ *                lignes, lignes de map[][] lues telles quelles): partie précédente, sinon niveau
+ *                préparé; partie sauvegardée en fin de partie dans un fichier distinct du niveau
+ *      v1.22   - option FRAME_STATS: durée de chaque étape des frames (timer 2 du VIA), min / moyenne /
+ *                max sur les 16 dernières frames affichés sous la fenêtre; aucun code sans l'option
+ *      v1.23   - option INPUT_TRACE: enregistrement de la partie (graine, événements clavier par frame,
+ *                sommes de contrôle de la fenêtre), rejouée sur PC par host/replay (make replay)
  */ 
 
 
-#include <stdio.h>
-#include <sys/graphics.h>
-//#include <lib.h> // désativé, car définition de fonction rand() buggée ici
-
-
-/* ================== TYPES ================== */
-typedef unsigned char uchar;
-typedef unsigned char bool; // boolean
-
-
-/* ================== CONSTANTES ================== */
-
-#ifndef NULL
-#define NULL ((void *) 0)
-#endif
-
-#ifndef FALSE
-#define FALSE ((bool) 0)
-#define TRUE  (!FALSE)
-#endif
-
-// Adresse de début de l'écran TEXT
-#define TEXT_SCREEN 0xBB80
-
-// Dimensions de l'écran
-#define SCREEN_WIDTH  40
-#define SCREEN_HEIGHT 28
-
-// Dimensions X et Y de la fenêtre d'affichage
-#define WIN_XSIZE  30
-#define WIN_YSIZE  15
-
-// Coordonnées du coin supérieur gauche de la fenêtre d'affichage
-#define WX  5
-#define WY  5
-
-// Dimensions X et Y de la carte
-#define MAP_XSIZE   100
-#define MAP_YSIZE   100
-
-// Divisions et multiplications entières par multiples de 2
-// en utilisant des opérations de décalage de bits
-// NB: ces macros  n'ont d'intérêt que sur des arguments qui sont des VARIABLES
-//     En effet les calculs sur des littéraux ou des constantes déclarées par #define
-//     sont normalement effectués dès la compilation pour simplifier la valeur
-//     des expressions (à confirmer peut-être pour lcc ??)
-//     
-#define div2(x) ((x) >> 1)
-#define div4(x) ((x) >> 2)
-#define div8(x) ((x) >> 3)
-#define mul2(x) ((x) << 1)
-#define mul4(x) ((x) << 2)
-#define mul8(x) ((x) << 3)
-
-
-
-
-// Caractères utilisés pour la carte, le joueur, et le contour de la fenêtre
-#define C_EMPTY ' '    // empty cell = SPACE = (uchar) 32
-#define C_WALL  '#'
-#define C_TREE  '^'
-#define C_WATER  '%'
-#define C_HILL1  '/'
-#define C_HILL2  '\\'  // Rappel: en C il faut doubler le caractère antislash, qui est sinoninterprété
-                       // comme un caractère 'escape' introduisant une séquence de contrôle (ex: '\n')
-#define C_PLAYER '*'
-#define C_CHECKERBOARD ((char) 126) // caractère 'damier'
-
-
-// Valeurs de chaque type de case, sur 4 bits maxi (donc 16 valeurs max possibles, de 0 à 15)
-#define V_EMPTY ((char) 0)
-#define V_WALL  ((char) 1)
-#define V_TREE  ((char) 2)
-#define V_WATER ((char) 3)
-#define V_HILL1 ((char) 4)
-#define V_HILL2 ((char) 5)
-
-// tableau indexé des caractères C_xxx correspondant aux constantes V_xxx (indexé par constantes V_xxx)
-char c_values[] = { C_EMPTY, C_WALL, C_TREE, C_WATER, C_HILL1, C_HILL2};
-
-#define get_cvalue(v_value) (c_values[v_value])
-
-// déterminer si un nombre (n° de case) est pair ou impair: il suffit juste de tester le bit 0 du nombre...
-#define is_even(x) (((x) & 1) == 0)
-#define is_odd(x)  (((x) & 1) != 0)
-
-// Manipulation des quartets d'une cellule
-// Le quartet supérieur ("poids fort") représentera TOUJOURS une cellule de n° PAIR
-// Le quartet inférieur ("poids faible") représentera TOUJOURS une cellule de n° IMPAIR
-#define get_high_quartet(val)  (((val) & 0xF0) >> 4)
-#define get_low_quartet(val)    ((val) & 0x0F)
-
-// renvoie le quartet de la valeur correspondant au  n° de cellule (quartet inférieur ou supérieur selon si le N° est impair ou pair)
-#define get_cellvalue(x, val) (is_odd(x) ?  get_low_quartet(val) :  get_high_quartet(val))
-
-#define get_map_cell_value(y,x) (is_odd(x) ?  \
-                                       get_low_quartet(map[y][div2(x)])  \
-                                    :  get_high_quartet(map[y][div2(x)]))
-
-// pour affecter une double valeur, on passera TOUJOUTS les quartets dans l'ordre (SUPERIEUR, INFERIEUR)
-// pour correspondre à l'ordre des cases (1ere case PAIRE? 2e case IMPAIRE)
-#define combine_cellvalues(highval, lowval)    ((highval << 4) | lowval)
-#define set_cellvalues(addr, highval, lowval)  ((*addr) = combine_cellvalues(highval, lowval))
-
-// Scan codes des touches du clavier
-#define KEY_LEFT  172
-#define KEY_RIGHT 188
-#define KEY_DOWN  180
-#define KEY_UP    156
-#define KEY_SPACE 132
-#define KEY_ESC   169
 
-#define NO_KEY 0x38 // NO KEY PRESSED
-
-
-/* ================== VARIABLES GLOBALES ================== */
-
-// Représentation de la carte, chaque case est un caractère (char)
-// BRANCHE "2_cells_per_byte": on regroupe 2 valeurs en 1 octet => dimension X du tableau = XSIZE/2
-// (condition: que XSIZE soit pair... ce qui simplifie aussi grandement tous les calculs)
-char map[MAP_YSIZE][MAP_XSIZE/2];
-
-/* adresse contenant la dernière touche pressée du clavier */
-uchar *keyb_norm_key_press_addr = (uchar *) 0x208;
+#include "movingmap.h"
 
 
 /* ================== DECLARATION DES FONCTIONS (PROTOTYPES) ================== */
-void  init_map();
-void  display_window();
-void  play_map();
 void  display_title_screen();
-void  wait_spacekey();
-uchar rnd(uchar max);
-uchar get_valid_keypress();
 void  test_keys();
-void  hide_cursor();
-void  show_cursor();
 void  test_division_entiere();
 
 /* ================== IMPLEMENTATION DES FONCTIONS ================== */
@@ -175,6 +90,9 @@ void  test_division_entiere();
  * main(): Point d'entrée du programme
  */  
 void main() {
+#ifdef MAP_FILE
+    map_info info;
+#endif
 	//test_keys();
 
     cls(); paper(4); ink(2);
@@ -185,14 +103,41 @@ void main() {
     //test_division_entiere();
 
     display_title_screen();
+    rnd_seed(MAP_SEED);
+#ifdef MAP_FILE
+    // partie précédente, sinon niveau préparé, sinon carte générée
+    if(map_file_load(STORE_SAVE, &info) || map_file_load(STORE_DATA, &info)) {
+        printf("  Carte %ux%u (graine %u)\n", info.width, info.height, info.seed);
+    }
+    else {
+        info.seed = MAP_SEED;
+        init_map();
+    }
+#else
     init_map();
+#endif
+#ifdef MINIMAP
+    minimap_build();
+#endif
 
     cls();
     display_window();
 
+#ifdef INPUT_TRACE
+    // partie enregistrée en RAM (trace_data[], trace_sums[]), à extraire de l'émulateur pour host/replay
+    trace_seed = MAP_SEED;
+    trace_start(TRACE_RECORD);
+#endif
+
     //test_keys();
     play_map();
 
+#ifdef MAP_FILE
+    // sauvegarde de la partie (fichier distinct du niveau): carte et position du personnage
+    info.start = map_start;
+    map_file_save(&info);
+#endif
+
 	// End game: show the cursor and quit
     show_cursor();
 }
@@ -208,247 +153,6 @@ void test_division_entiere() {
     wait_spacekey();
 }
 
-/** 
- * init_map(): initialisation du tableau représentant la carte 
- */
-void init_map() {
-    uchar i, j, k, kx, ky, n;
-    uchar xmax_inside; // coord x max entre les murs d'enceinte
-    uchar ymax_inside; // coord y max entre les murs d'enceinte
-    char *cell_addr1, *cell_addr2; // optimisation v1.2
-
-
-    // ceinturer la carte de murs ('#') et la remplir de blancs (espaces)
-    printf("Ajout des murs d'enceinte...\n");
-
-    // Murs horizontaux haut & bas
-    cell_addr1 = &map[0][0];
-    cell_addr2 = &map[MAP_YSIZE-1][0];
-    for(i=0; i < MAP_XSIZE/2; i++) {
-        // map[0][i] = WALL;
-        set_cellvalues(cell_addr1++, V_WALL, V_WALL);
-        //map[MAP_YSIZE-1][i] = WALL;
-        set_cellvalues(cell_addr2++, V_WALL, V_WALL);
-    }
-
-    // Murs verticaux gauche/droit, avec case vide après/avant
-    cell_addr1 = &map[1][0];
-    cell_addr2 = &map[1][MAP_XSIZE/2-1];
-    for(i=1; i < (MAP_YSIZE-1); i++) {
-        //map[i][0] = WALL;
-        set_cellvalues(cell_addr1, V_WALL, V_EMPTY);
-        cell_addr1 += MAP_XSIZE/2;
-        //map[i][MAP_XSIZE-1] = WALL;
-        set_cellvalues(cell_addr2, V_EMPTY, V_WALL);
-        cell_addr2 += MAP_XSIZE/2;
-    }
-
-    // Initialiser l'intérieur de la carte avec des blancs (= cases 'vides')
-    printf("Remplissage de la carte de blancs...\n");
-    #define YMAX_INSIDE (MAP_YSIZE-1)
-    #define XMAX_INSIDE (MAP_XSIZE/2-1)
-
-    cell_addr1 = &map[1][1];
-    for(i = 1; i < YMAX_INSIDE; i++) {
-        for(j = 1; j < XMAX_INSIDE; j++) {
-            //map[i][j] = EMPTY;
-            set_cellvalues(cell_addr1, V_EMPTY, V_EMPTY);
-            cell_addr1++;
-
-        }
-        cell_addr1 += 2; // sauter double case (XMAX-2, XMAX-1) et double case (0,1) de la ligne suivante
-    }
-
-    // Ajouter de 200 a 250 arbres
-    // (ATTENTION ici on ne peut pas dépasser 255 car n est un "uchar",
-    //  et la fonction rnd() elle-même attend un uchar en parametre !!!)
-    n = rnd(200)+51; // ne marche pas si #include <lib.h>
-    //n = 230;
-    printf("Ajout de %d arbres...\n", n);
-    for(k = 0; k < n; k++) {
-        kx = rnd(MAP_YSIZE-3)+1;
-        ky = rnd(MAP_XSIZE-3)+1;
-        map[ky][div2(kx)] = is_even(kx) ? combine_cellvalues(V_TREE, V_EMPTY) : combine_cellvalues(V_EMPTY, V_TREE);
-    }
-    // Ajouter de 60 a 100 montagnes
-   n = rnd(60)+41; // ne marche pas si #include <lib.h>
-   //n = 71;
-    printf("Ajout de %d montagnes...\n", n);
-    for(k = 0; k < n; k++) {
-        kx = rnd(MAP_XSIZE-5)+1;
-        ky = rnd(MAP_YSIZE-2)+1;
-        //map[ky][kx++] = HILL1;
-        //map[ky][kx]   = HILL2;
-        if(is_odd(kx)) kx++; // Pour simplifier on "aligne" le début d'une montagne sur une case "paire"
-        cell_addr1 = &map[ky][div2(kx)];
-        set_cellvalues(cell_addr1, V_HILL1, V_HILL2); 
-    }
-
-    // Ajouter de 30 a 50 lacs de 4x3 cases
-    n = rnd(30)+21; // ne marche pas si #include <lib.h>
-    //n = 41;
-    printf("Ajout de %d lacs...\n", n);
-    for(k = 0; k < n; k++) {
-        kx = rnd(MAP_XSIZE-8)+1;
-        ky = rnd(MAP_YSIZE-5)+1;
-
-        // - 1e ligne du lac
-        //map[ky][kx] = WATER; map[ky][kx+1] = WATER; map[ky][kx+2] = WATER;
-        //ky++; // Incrémmenter ky pour la ligne suivante
-        //kx++; // et incrémenter aussi kx pour décaler d'une case à droite
-        cell_addr1 = &map[ky][kx/2];
-        set_cellvalues(cell_addr1++, V_WATER, V_WATER); 
-        set_cellvalues(cell_addr1++, V_WATER, V_WATER); 
-
-        // - 2e ligne du lac
-        //map[ky][kx] = WATER; map[ky][kx+1] = WATER; map[ky][kx+2] = WATER;
-        //ky++; // Incrémmenter ky pour la ligne suivante
-        //kx++; // et incrémenter aussi kx pour décaler d'une case à droite
-        cell_addr1 += MAP_XSIZE/2; 
-        // on est déjà décalé d'une case à droite après passage à la ligne à cause du dernier 'cell_addr1++'
-        set_cellvalues(cell_addr1--, V_WATER, V_EMPTY); 
-        set_cellvalues(cell_addr1--, V_WATER, V_WATER); 
-        set_cellvalues(cell_addr1++, V_EMPTY, V_WATER); 
-        // noter le dernier "cell_addr1++" pour se remettre en décalage d'une cellule à droite
-
-        // - 3e ligne du lac
-        //map[ky][kx] = WATER; map[ky][kx+1] = WATER; map[ky][kx+2] = WATER;
-        cell_addr1 += MAP_XSIZE/2;
-        set_cellvalues(cell_addr1++, V_WATER, V_WATER); 
-        set_cellvalues(cell_addr1,   V_WATER, V_WATER); 
-    }
-}
-
-/** 
- * display_window(): affichage du contour de la fenêtre d'affichage de la carte
- */
-void display_window() {
-    uchar y, x;
-    char *addr = (char *) (TEXT_SCREEN + WY*SCREEN_WIDTH + WX);
-
-    #define WIN_EXT_WIDTH   (WIN_XSIZE + 2)  // largeur totale de la fenêtre avec son cadre
-    #define WIN_EXT_HEIGHT  (WIN_YSIZE + 2)  // hauteur totale de la fenêtre avec son cadre
-
-    // trait haut
-    for(x=0; x < WIN_EXT_WIDTH; x++) {
-        *addr++ = C_CHECKERBOARD; // caractère damier
-    }
-    addr += (SCREEN_WIDTH - WIN_EXT_WIDTH);
-    // traits verticaux gauche et droit
-    for(y=1; y < WIN_EXT_HEIGHT-1; y++) {
-        *addr = C_CHECKERBOARD; // caractère damier
-        addr += WIN_EXT_WIDTH-1;
-        *addr = C_CHECKERBOARD; // caractère damier
-        addr += (SCREEN_WIDTH - WIN_EXT_WIDTH + 1);
-    }
-    // trait bas
-    for(x=0; x < WIN_EXT_WIDTH; x++) {
-        *addr++ = C_CHECKERBOARD; // caractère damier
-    }
-    // Affichage des instructions sous la fenêtre:
-    gotoxy(WX+4, WY+WIN_EXT_HEIGHT);   printf("Deplacements: fleches");
-    gotoxy(WX+4, WY+WIN_EXT_HEIGHT+1); printf("    ESC = quitter");
-}
-
-/** 
- * play_map(): affichage de la carte et boucle principale de gestion du clavier et des déplacements
- */
-void play_map() { 
-    uchar x, y;    // coordonnees ABSOLUES du personnage dans la map
-    uchar px,py;   // coordonnees RELATIVES du personnage dans la fenêtre d'affichage
-    uchar xv, yv;  // coordonnées de départ (offset) de la map pour l'affichage dans la fenêtre
-    uchar i, j;
-    char *addr;
-    // optimisation v1.1: current_cell_addr = adresse case courante du tableau de la carte à afficher,
-    //      initialisée à chaque "balayage" avec la coordonnée du coin supérieur gauche 
-    //      de la partie visible du tableau de la carte à afficher
-    char *current_cell_addr; // optimisation v1.1
-    
-    #define ADDR_INFOLINE1 (char *) (TEXT_SCREEN + (WY-2)*SCREEN_WIDTH + WX+2)
-    #define ADDR_INFOLINE2 (char *) (ADDR_INFOLINE1 + SCREEN_WIDTH)
-
-    uchar key = NO_KEY;
-    bool end = FALSE;
-
-    x = 50; y = 50;
-
-    // Boucle principale:
-    // - affichage de la partie visible de la carte dans la fenêtre
-    // - gestion du clavier pour les déplacements et la 'fin de partie'
-    while(!end) {
-        // Calcul coordonnées coin supérieur gauche (xv, yv) de la partie de la carte à afficher
-        // en fonction des coordonnées (x,y) courantes du 'joueur'
-        if(x <= WIN_XSIZE/2) xv = 0; else xv = x - WIN_XSIZE/2;
-        if(y <= WIN_YSIZE/2) yv = 0; else yv = y - WIN_YSIZE/2;
-        //  Corrections pour affichage extrémités droite et inferieure de la carte
-        if(x >= MAP_XSIZE-WIN_XSIZE/2) xv = MAP_XSIZE-WIN_XSIZE;
-        if(y >= MAP_YSIZE-WIN_YSIZE/2) yv = MAP_YSIZE-WIN_YSIZE;
-        // Affichage de la partie de la partie visible de la carte dans la fenêtre
-        addr = (char *) (TEXT_SCREEN + (WY+1)*SCREEN_WIDTH + WX+1);
-        current_cell_addr = &map[yv][div2(xv)]; // optimisation v1.1
-        for(i=yv; i < (yv+WIN_YSIZE); i++) {
-            for(j=xv; j < (xv+WIN_XSIZE); j++) {
-                // *addr++ = map[i][j];
-                
-                /*
-                gotoxy(WX, WY+WIN_EXT_HEIGHT+3);
-                printf("i/y=%d, j/x=%d ", i, j);
-                gotoxy(WX, WY+WIN_EXT_HEIGHT+4);
-                printf("cell addr=%x, val=%x, char=%c", 
-                               current_cell_addr, 
-                               *current_cell_addr,
-                               get_cvalue(get_cellvalue(j, *current_cell_addr)));
-                wait_spacekey();
-                */
-
-                //*addr++ = get_cvalue(get_cellvalue(j, *current_cell_addr));
-                if(is_odd(j)) {
-                    // NB: on incrémente le pointeur de cellule du tableau uniquement après case impaire
-                    *addr++ = get_cvalue(get_low_quartet(*current_cell_addr++));
-                } 
-                else { // even
-                    *addr++ = get_cvalue(get_high_quartet(*current_cell_addr));
-                    // NB: ici, pas d'incrément du pointeur current_cell_addr, car case paire
-                    // et la prochaine case impaire à afficher est la valeur du quartet inférieur
-                }
-            }
-            addr += (SCREEN_WIDTH - WIN_XSIZE);
-            current_cell_addr += (MAP_XSIZE - WIN_XSIZE)/2;
-
-        }
-        // Affichage personnage: PX et PY sont les coordonnees relatives
-        if(x > WIN_XSIZE/2) px = x - xv; else px = x;
-        if(y > WIN_YSIZE/2) py = y - yv; else py = y;
-        addr = (char *) (TEXT_SCREEN + (WY+1+py)*SCREEN_WIDTH + WX+1+px);
-        *addr = C_PLAYER;
-
-        // affichage infos coordonnées courantes du 'joueur'
-        sprintf(ADDR_INFOLINE1, "X=%d, PX=%d, Y=%d, PY=%d    ", x, px, y, py);
-        sprintf(ADDR_INFOLINE2, "XV=%d, YV=%d  ", xv, yv);
-
-        // Gestion du clavier pour les déplacements et la 'fin de partie'
-        key = get_valid_keypress();
-        switch(key) {
-            case KEY_ESC:
-                end = TRUE;
-                break;
-            case KEY_LEFT:
-                if(x > 0 && get_map_cell_value(y, x-1) == V_EMPTY) x--;
-                break;
-            case KEY_RIGHT:
-                if(x < (MAP_XSIZE-1) && get_map_cell_value(y, x+1) == V_EMPTY) x++;
-                break;
-            case KEY_UP:
-                if(y > 0 && get_map_cell_value(y-1, x) == V_EMPTY) y--;
-                break;
-            case KEY_DOWN:
-                if(y < (MAP_YSIZE-1) && get_map_cell_value(y+1, x) == V_EMPTY) y++;
-                break;
-        }
-    }
-
-}
-
 /** 
  * display_title_screen(): affichage d'un écran titre
  */
@@ -459,80 +163,19 @@ void display_title_screen() {
 	printf("\n\n\n\n\n");    
 	printf("  Demo carte deroulante en C\n");
     printf("  --------------------------\n");
-    printf("\n\n\n");
-    printf("Initialisation en cours...\n");
-}
-
-/** 
- * Attend une pression sur la touche ESPACE 
- */
-void wait_spacekey() {
-    uchar key = NO_KEY;
-    // wait for space key pressed
-	for(; key != KEY_SPACE;) {
-		key = *keyb_norm_key_press_addr;
-	}
-    // wait for key release
-	for(; key != NO_KEY;) {
-		key = *keyb_norm_key_press_addr;
-	}
-}
-
-/** 
- * rnd(uchar max) : renvoie un nombre aléatoire (entier positif) dans l'intervalle  [0...max[
- *  arg max: borne supérieure délimitant l'intervalle des nombres aléatoires générés
- *           (type unsigned char ==> valeur maxi : 255)
- */
-uchar rnd(uchar max) {
-    // ATTENTION - ne PAS inclure <lib.h> sinon ça fait bugger la définition de rand()
-    // qui renvoie systématiquement zéro !!
-    uchar val = (uchar) (rand()/(32768/max));
-    //printf("rnd(%d)=%d -- press space  \n", max, val); wait_spacekey();
-    return val;
-}
-
-/** 
- * get_valid_keypress(): scanne le clavier jusqu'à ce qu'une touche valide soit
- * pressée, et renvoie le code correspondant (type uchar)
- */
-uchar get_valid_keypress() {
-	uchar key = NO_KEY;
-	uchar debounce;
-    bool valid = FALSE;
-
-	do {
-		key = *keyb_norm_key_press_addr;
-		valid = (	(key == KEY_LEFT)
-				 || (key == KEY_RIGHT)
-				 || (key == KEY_UP)
-				 || (key == KEY_DOWN)
-                 || (key == KEY_ESC)
-                );
-	} while(!valid);
-	// debounce: wait until key is released
-    // wait for key release
-	//debounce = key;
-	//for(; debounce != NO_KEY;) {
-	//	debounce = *keyb_norm_key_press_addr;
-    //	}
-	// finally, return code of valid key pressed
-	return key;
 }
 
-
-
 // ======================================================================
 // Test Keys: display scan code of pressed key (press SPACE to exit test)
 // ======================================================================
 void test_keys() {
-    unsigned char *keyb_norm_key_press_addr = (unsigned char *) 0x208;
     unsigned char key      = NO_KEY; // 0x38 = NO KEY PRESSED
     unsigned char prev_key = NO_KEY; // 0x38 = NO KEY PRESSED
     
     printf("Keypress test -- press SPACE to end\n");
 
     for(; key != KEY_SPACE;) { // loop until SPACE is pressed to quit
-        key = *keyb_norm_key_press_addr;
+        key = read_key();
         if(key != NO_KEY) {	// 0x38 = NO KEY PRESSED
             if(key != prev_key) {
                 // Do not log repeat key presses
@@ -542,22 +185,3 @@ void test_keys() {
         }
     }  
 }
-
-/**
- * hide_cursor(): cache le curseur 
- */ 
-void hide_cursor() {
-	// Hide the cursor: clear bit 0 @ 0x26A
-	uchar *addr = (uchar *) 0x26A;
-	*addr &= 0xFE;
-}
-
-/**
- * hide_cursor(): montre le curseur 
- */ 
-void show_cursor() {
-	// End game: show cursor: set bit 0 @ 0x26A
-	uchar *addr = (uchar *) 0x26A;
-	*addr |= 1;
-}
-
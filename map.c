@@ -0,0 +1,498 @@
+/**
+ *      CTextMovingMap - map.c
+ *      ======================
+ * 
+ *      Représentation de la carte (tableau map[][], 2 cellules par octet), génération
+ *      aléatoire de son contenu (init_map) et générateur pseudo-aléatoire reproductible (rnd)
+ */
+
+#include "movingmap.h"
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// tableau indexé des caractères C_xxx correspondant aux constantes V_xxx (indexé par constantes V_xxx)
+char c_values[] = { C_EMPTY, C_WALL, C_TREE, C_WATER, C_HILL1, C_HILL2};
+
+#define NB_CVALUES (sizeof(c_values)/sizeof(c_values[0]))
+
+// tables de décodage des octets de la carte (2 cellules par octet), indexées par la valeur de l'octet:
+// caractère de la cellule PAIRE (quartet supérieur) et de la cellule IMPAIRE (quartet inférieur)
+// (construites à partir de c_values[] par init_cell_chars())
+char cell_char_even[256];
+char cell_char_odd[256];
+
+#ifdef MAP_DENSE
+// plan de praticabilité: 1 bit par cellule (voir movingmap.h), et masque de la cellule x: walk_bit[x & 7]
+uchar walk_plane[MAP_YSIZE][WALK_PLANE_BYTES];
+uchar walk_bit[8] = { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 };
+
+// table de décodage octet de la carte => 2 bits de praticabilité (bit 1: cellule paire, bit 0: impaire)
+// (construite à partir de PASSABLE_VALUES par init_cell_chars())
+static uchar walk_pairs[256];
+#endif
+
+// Représentation de la carte, chaque case est un caractère (char)
+// BRANCHE "2_cells_per_byte": on regroupe 2 valeurs en 1 octet => dimension X du tableau = XSIZE/2
+// (condition: que XSIZE soit pair... ce qui simplifie aussi grandement tous les calculs)
+#ifdef MAP_DENSE
+char map[MAP_YSIZE][MAP_XSIZE/2];
+#endif
+
+// point de départ du personnage: centre de la carte (ou position lue par map_file_load())
+position map_start = { MAP_XSIZE/2, MAP_YSIZE/2 };
+
+// état du générateur xorshift 16 bits (jamais nul, voir rnd())
+// (unsigned short: 16 bits aussi sur PC, où un unsigned int en fait 32)
+static unsigned short rnd_state = 1;
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/** 
+ * init_cell_chars(): construction des tables de décodage cell_char_even[] et cell_char_odd[]
+ * à partir de c_values[] (un quartet sans valeur V_xxx correspondante est affiché comme C_EMPTY),
+ * et en mode MAP_DENSE de la table walk_pairs[] à partir de PASSABLE_VALUES
+ */
+void init_cell_chars() {
+    uchar hi, lo;
+    char *even_addr = cell_char_even;
+    char *odd_addr  = cell_char_odd;
+#ifdef MAP_DENSE
+    uchar *walk_addr = walk_pairs;
+#endif
+
+    for(hi = 0; hi < 16; hi++) {
+        for(lo = 0; lo < 16; lo++) {
+            *even_addr++ = (hi < NB_CVALUES) ? get_cvalue(hi) : C_EMPTY;
+            *odd_addr++  = (lo < NB_CVALUES) ? get_cvalue(lo) : C_EMPTY;
+#ifdef MAP_DENSE
+            *walk_addr++ = (is_passable(hi) << 1) | is_passable(lo);
+#endif
+        }
+    }
+}
+
+#ifdef MAP_TILED
+
+/** 
+ * init_map(): en mode MAP_TILED, le monde est déjà sur le support externe (voir host/mkworld.c):
+ * il suffit d'initialiser le cache de tuiles
+ */
+void init_map() {
+    init_cell_chars();
+    printf("Ouverture du monde (%dx%d)...\n", MAP_XSIZE, MAP_YSIZE);
+    tile_cache_init();
+}
+
+#elif defined(MAP_RLE)
+
+/** 
+ * init_map(): en mode MAP_RLE, la carte compressée fait partie du programme (données générées
+ * par host/mkworld -f rle): rien à calculer
+ */
+void init_map() {
+    init_cell_chars();
+    printf("Carte compressee (%dx%d, %u octets)\n", MAP_XSIZE, MAP_YSIZE, map_rle_rows[MAP_YSIZE]);
+}
+
+#elif defined(MAP_LAZY)
+
+// nombre d'éléments de terrain par région de REGION_SIZE x REGION_SIZE cellules: rnd(n)+base,
+// soit en moyenne la même densité que init_map() en mode MAP_DENSE
+#define REGION_TREES_N  7
+#define REGION_TREES    1
+#define REGION_HILLS_N  3
+#define REGION_HILLS    1
+#define REGION_LAKES_N  3
+#define REGION_LAKES    0
+
+// passes de placement, dans l'ordre (les lacs recouvrent les montagnes, qui recouvrent les arbres)
+#define PASS_TREES 0
+#define PASS_HILLS 1
+#define PASS_LAKES 2
+
+uchar region_done[REGIONS_Y][REGIONS_X];
+
+// clé du monde, tirée de la graine par init_map(): base des graines de chaque région
+static unsigned int world_key;
+
+// limites (exclues pour x1, y1) de la région en cours de génération
+static coord region_x0, region_y0, region_x1, region_y1;
+
+/** 
+ * init_map(): en mode MAP_LAZY, rien n'est généré: toutes les régions sont marquées "à générer"
+ * (la graine choisie auparavant par rnd_seed() détermine toujours toute la carte)
+ */
+void init_map() {
+    uchar *done = &region_done[0][0];
+    uchar i;
+
+    init_cell_chars();
+    world_key = rnd16();
+
+    for(i = 0; i < REGIONS_Y*REGIONS_X; i++) {
+        *done++ = 0;
+    }
+}
+
+/** 
+ * region_run(y, x, n, v): pose de n cellules de valeur v à partir de la cellule (y, x), limitée
+ * à la région en cours de génération
+ */
+static void region_run(coord y, coord x, uchar n, uchar v) {
+    char *cell_addr;
+
+    if(y < region_y0 || y >= region_y1) return;
+    for(; n > 0; n--, x++) {
+        if(x < region_x0 || x >= region_x1) continue;
+        cell_addr = &map[y][div2(x)];
+        if(is_odd(x)) *cell_addr = (*cell_addr & 0xF0) | v;
+        else          *cell_addr = (*cell_addr & 0x0F) | (v << 4);
+    }
+}
+
+/** 
+ * region_stamps(pass, ry, rx): éléments de terrain de la passe pass ancrés dans la région (ry, rx),
+ * tirés avec la graine de cette région et de cette passe, et posés dans la région en cours de
+ * génération (un lac ou une montagne peut déborder sur la région voisine à droite ou en bas).
+ * Un élément qui ne tient pas entre les murs d'enceinte est ignoré.
+ */
+static void region_stamps(uchar pass, uchar ry, uchar rx) {
+    uchar k, n, ax, ay, r;
+    unsigned int kx, ky;
+
+    rnd_seed((world_key + (((unsigned int) ry << 8) | rx)) * 0x9E37u + pass * 0x3B1Du);
+    rnd16(); // premiers tirages d'un xorshift peu mélangés pour des graines proches
+
+    if(pass == PASS_TREES)      n = rnd(REGION_TREES_N) + REGION_TREES;
+    else if(pass == PASS_HILLS) n = rnd(REGION_HILLS_N) + REGION_HILLS;
+    else                        n = rnd(REGION_LAKES_N) + REGION_LAKES;
+
+    for(k = 0; k < n; k++) {
+        ax = rnd(REGION_SIZE);
+        ay = rnd(REGION_SIZE);
+        kx = ((unsigned int) rx << REGION_SHIFT) + ax;
+        ky = ((unsigned int) ry << REGION_SHIFT) + ay;
+        if(ky < 1) continue;
+
+        if(pass == PASS_TREES) {
+            if(kx < 1 || kx > MAP_XSIZE-2 || ky > MAP_YSIZE-2) continue;
+            region_run(ky, kx, 1, V_TREE);
+        }
+        else if(pass == PASS_HILLS) {
+            // début d'une montagne aligné sur une case "paire", comme en mode MAP_DENSE
+            kx &= ~1u;
+            if(kx < 2 || kx+1 > MAP_XSIZE-2 || ky > MAP_YSIZE-2) continue;
+            region_run(ky, kx, 1, V_HILL1);
+            region_run(ky, kx+1, 1, V_HILL2);
+        }
+        else {
+            // lac de 4x3 cases, chaque ligne décalée d'une case à droite
+            kx &= ~1u;
+            if(kx < 2 || kx+5 > MAP_XSIZE-2 || ky+2 > MAP_YSIZE-2) continue;
+            for(r = 0; r < 3; r++) {
+                region_run(ky+r, kx+r, 4, V_WATER);
+            }
+        }
+    }
+}
+
+/** 
+ * generate_region(ry, rx): génération de la région (ry, rx) de la carte: fond vide, murs
+ * d'enceinte, puis pour chaque passe les éléments ancrés dans cette région ou dans ses voisines
+ * de gauche / du haut, toujours dans le même ordre: le résultat ne dépend que de la graine,
+ * pas de l'ordre dans lequel les régions sont visitées. Renvoie toujours 1 (voir map_region_ready())
+ * Les tirages de la région réamorcent le générateur: son état est rétabli à la fin, la suite des
+ * tirages du jeu (entités...) ne dépend donc pas des régions découvertes
+ */
+uchar generate_region(uchar ry, uchar rx) {
+    uchar pass, i, j, nbytes;
+    char *cell_addr;
+    char fill;
+    unsigned short game_state = rnd_state;
+
+    region_x0 = (coord) (rx << REGION_SHIFT);
+    region_y0 = (coord) (ry << REGION_SHIFT);
+    region_x1 = (rx == REGIONS_X-1) ? MAP_XSIZE : region_x0 + REGION_SIZE;
+    region_y1 = (ry == REGIONS_Y-1) ? MAP_YSIZE : region_y0 + REGION_SIZE;
+    nbytes = div2(region_x1 - region_x0);
+
+    // fond vide, murs d'enceinte sur les bords de la carte
+    for(i = region_y0; i < region_y1; i++) {
+        cell_addr = &map[i][div2(region_x0)];
+        fill = (i == 0 || i == MAP_YSIZE-1) ? combine_cellvalues(V_WALL, V_WALL)
+                                            : combine_cellvalues(V_EMPTY, V_EMPTY);
+        for(j = 0; j < nbytes; j++) {
+            *cell_addr++ = fill;
+        }
+        if(region_x0 == 0)         map[i][0] |= combine_cellvalues(V_WALL, V_EMPTY);
+        if(region_x1 == MAP_XSIZE) map[i][MAP_XSIZE/2-1] |= combine_cellvalues(V_EMPTY, V_WALL);
+    }
+
+    for(pass = PASS_TREES; pass <= PASS_LAKES; pass++) {
+        if(ry > 0 && rx > 0) region_stamps(pass, ry-1, rx-1);
+        if(ry > 0)           region_stamps(pass, ry-1, rx);
+        if(rx > 0)           region_stamps(pass, ry, rx-1);
+        region_stamps(pass, ry, rx);
+    }
+
+    rnd_state = game_state;
+    walk_plane_update(region_y0, region_x0, (uchar) (region_y1 - region_y0), (uchar) (region_x1 - region_x0));
+    region_done[ry][rx] = 1;
+    return 1;
+}
+
+/** 
+ * map_prepare(y, x, h, w): génération des régions pas encore générées du rectangle de h x w
+ * cellules de coin supérieur gauche (y, x), avant son affichage
+ */
+void map_prepare(coord y, coord x, uchar h, uchar w) {
+    uchar ry, rx;
+    uchar ry1 = (uchar) ((y + h - 1) >> REGION_SHIFT);
+    uchar rx1 = (uchar) ((x + w - 1) >> REGION_SHIFT);
+
+    for(ry = y >> REGION_SHIFT; ry <= ry1; ry++) {
+        for(rx = x >> REGION_SHIFT; rx <= rx1; rx++) {
+            if(!region_done[ry][rx]) generate_region(ry, rx);
+        }
+    }
+}
+
+#else
+
+// tirages d'une passe de placement (coordonnées x et y des éléments de terrain, voir rnd_fill())
+#define PLACE_MAX 255
+static uchar place_x[PLACE_MAX];
+static uchar place_y[PLACE_MAX];
+
+// adresse du début de chaque ligne de la carte (évite le calcul 2D ligne * MAP_XSIZE/2 à chaque élément)
+static char *map_rows[MAP_YSIZE];
+
+/** 
+ * init_map(): initialisation du tableau représentant la carte à partir de la graine choisie
+ * auparavant par rnd_seed(): même graine => même carte
+ * 
+ * Une passe séquentielle pour les murs et le fond vide, puis, pour chaque type de terrain,
+ * tirage de toutes les positions d'un bloc (rnd_fill()) avant de les poser: pas de boucle
+ * de rejet, le pire cas est borné par le nombre maxi d'éléments de chaque passe
+ */
+void init_map() {
+    uchar i, j, k, n;
+    char *cell_addr1, *cell_addr2; // optimisation v1.2
+    char **row_addr;
+    uchar *px, *py;
+
+    // tables de décodage pour l'affichage, toujours synchronisées avec c_values[]
+    init_cell_chars();
+
+    // ceinturer la carte de murs ('#') et la remplir de blancs (espaces), ligne par ligne
+    cell_addr1 = &map[0][0];
+    row_addr = map_rows;
+    for(i = 0; i < MAP_YSIZE; i++) {
+        *row_addr++ = cell_addr1;
+        if(i == 0 || i == MAP_YSIZE-1) {
+            // Murs horizontaux haut & bas
+            for(j = 0; j < MAP_XSIZE/2; j++) {
+                set_cellvalues(cell_addr1, V_WALL, V_WALL);
+                cell_addr1++;
+            }
+        }
+        else {
+            // Murs verticaux gauche/droit, avec case vide après/avant, et intérieur vide
+            set_cellvalues(cell_addr1, V_WALL, V_EMPTY);
+            cell_addr1++;
+            for(j = 2; j < MAP_XSIZE/2; j++) {
+                set_cellvalues(cell_addr1, V_EMPTY, V_EMPTY);
+                cell_addr1++;
+            }
+            set_cellvalues(cell_addr1, V_EMPTY, V_WALL);
+            cell_addr1++;
+        }
+    }
+
+    // Ajouter de 51 a 250 arbres
+    // (seul le quartet de la cellule de l'arbre est modifié: sa voisine, éventuellement un mur, est conservée)
+    n = rnd(200)+51;
+    rnd_fill(place_x, n, MAP_XSIZE-3);
+    rnd_fill(place_y, n, MAP_YSIZE-3);
+    px = place_x; py = place_y;
+    for(k = 0; k < n; k++) {
+        cell_addr1 = map_rows[*py++ + 1] + div2(*px + 1);
+        if(is_odd(*px++)) {
+            // cellule kx = *px + 1 paire: quartet supérieur
+            *cell_addr1 = (*cell_addr1 & 0x0F) | combine_cellvalues(V_TREE, V_EMPTY);
+        }
+        else {
+            *cell_addr1 = (*cell_addr1 & 0xF0) | combine_cellvalues(V_EMPTY, V_TREE);
+        }
+    }
+
+    // Ajouter de 41 a 100 montagnes
+    n = rnd(60)+41;
+    rnd_fill(place_x, n, MAP_XSIZE-5);
+    rnd_fill(place_y, n, MAP_YSIZE-2);
+    px = place_x; py = place_y;
+    for(k = 0; k < n; k++) {
+        // Pour simplifier on "aligne" le début d'une montagne sur une case "paire"
+        // (kx = *px + 1, arrondi à la case paire suivante si impair)
+        cell_addr1 = map_rows[*py++ + 1] + div2(*px++ + 2);
+        set_cellvalues(cell_addr1, V_HILL1, V_HILL2); 
+    }
+
+    // Ajouter de 21 a 50 lacs de 4x3 cases, chaque ligne décalée d'une case à droite
+    n = rnd(30)+21;
+    rnd_fill(place_x, n, MAP_XSIZE-8);
+    rnd_fill(place_y, n, MAP_YSIZE-5);
+    px = place_x; py = place_y;
+    for(k = 0; k < n; k++) {
+        row_addr = &map_rows[*py++ + 1];
+        j = div2(*px++ + 1);
+
+        // - 1e ligne du lac
+        cell_addr1 = *row_addr++ + j;
+        set_cellvalues(cell_addr1, V_WATER, V_WATER); cell_addr1++;
+        set_cellvalues(cell_addr1, V_WATER, V_WATER);
+
+        // - 2e ligne du lac
+        cell_addr2 = *row_addr++ + j;
+        set_cellvalues(cell_addr2, V_EMPTY, V_WATER); cell_addr2++;
+        set_cellvalues(cell_addr2, V_WATER, V_WATER); cell_addr2++;
+        set_cellvalues(cell_addr2, V_WATER, V_EMPTY);
+
+        // - 3e ligne du lac
+        cell_addr1 = *row_addr + j + 1;
+        set_cellvalues(cell_addr1, V_WATER, V_WATER); cell_addr1++;
+        set_cellvalues(cell_addr1, V_WATER, V_WATER);
+    }
+
+    // plan de praticabilité de toute la carte
+    walk_plane_update(0, 0, MAP_YSIZE, MAP_XSIZE);
+}
+
+#endif /* MAP_TILED / MAP_RLE / MAP_LAZY */
+
+#ifndef BLIT_ASM
+
+/** 
+ * map_walk_dirs(y, x): déplacements possibles depuis la cellule (y, x): bits WALK_xxx des
+ * cellules voisines praticables, dans les limites de la carte (en mode MAP_DENSE: un test de bit
+ * par voisine dans le plan de praticabilité; version assembleur: voir blit.s)
+ */
+uchar map_walk_dirs(coord y, coord x) {
+    uchar dirs = 0;
+
+    if(x > 0             && map_walkable(y, x-1)) dirs |= WALK_LEFT;
+    if(x < (MAP_XSIZE-1) && map_walkable(y, x+1)) dirs |= WALK_RIGHT;
+    if(y > 0             && map_walkable(y-1, x)) dirs |= WALK_UP;
+    if(y < (MAP_YSIZE-1) && map_walkable(y+1, x)) dirs |= WALK_DOWN;
+    return dirs;
+}
+
+#endif /* BLIT_ASM */
+
+#ifdef MAP_DENSE
+
+/** 
+ * set_map_cell(y, x, v): la cellule (y, x) de la carte prend la valeur V_xxx v (seul son quartet est
+ * modifié); son bit du plan de praticabilité et, avec MINIMAP, les comptes de son bloc sont mis à jour
+ * (avec FOG, le champ de vision sera recalculé).
+ * Les fenêtres ne sont pas redessinées: à l'appelant de réafficher la cellule si elle est visible
+ */
+void set_map_cell(coord y, coord x, uchar v) {
+    char *cell_addr = &map[y][div2(x)];
+#ifdef MINIMAP
+    uchar old_v = get_cellvalue(x, *cell_addr);
+#endif
+
+    if(is_odd(x)) *cell_addr = (*cell_addr & 0xF0) | combine_cellvalues(V_EMPTY, v);
+    else          *cell_addr = (*cell_addr & 0x0F) | combine_cellvalues(v, V_EMPTY);
+    if(is_passable(v)) walk_plane[y][x >> 3] |= walk_bit[x & 7];
+    else               walk_plane[y][x >> 3] &= ~walk_bit[x & 7];
+#ifdef MINIMAP
+    if(old_v != v) minimap_cell_changed(y, x, old_v, v);
+#endif
+#ifdef FOG
+    fov_invalidate();
+#endif
+}
+
+/** 
+ * walk_plane_update(y, x, h, w): reconstruction du plan de praticabilité pour le rectangle de h x w
+ * cellules de coin supérieur gauche (y, x), par octets entiers du plan (8 cellules = 4 octets de
+ * la carte, décodés par walk_pairs[]); les bits au-delà de la dernière colonne restent à 0
+ */
+void walk_plane_update(coord y, coord x, uchar h, uchar w) {
+    uchar i, j, k, bits;
+    uchar b0 = x >> 3, b1 = (x + w - 1) >> 3;
+    uchar *plane_addr;
+    char *cell_addr;
+
+    for(i = 0; i < h; i++, y++) {
+        plane_addr = &walk_plane[y][b0];
+        cell_addr = &map[y][b0 << 2];
+        for(j = b0; j <= b1; j++) {
+            bits = 0;
+            for(k = 0; k < 4; k++) {
+                bits <<= 2;
+                if((j << 2) + k < MAP_XSIZE/2) bits |= walk_pairs[(uchar) *cell_addr++];
+            }
+            *plane_addr++ = bits;
+        }
+    }
+}
+
+#endif /* MAP_DENSE */
+
+/* ================== GENERATEUR PSEUDO-ALEATOIRE ================== */
+
+// un pas du générateur xorshift 16 bits (décalages 7, 9, 8: période 65535)
+// (décalages de 8 et 9 = simples recopies d'octets sur 6502)
+#define rnd_step(s) { s ^= s << 7; s ^= s >> 9; s ^= s << 8; }
+
+/** 
+ * rnd_seed(seed): choix de la graine du générateur: une même graine redonne la même suite de
+ * tirages (et donc la même carte)
+ */
+void rnd_seed(unsigned int seed) {
+    rnd_state = (unsigned short) ((seed != 0) ? seed : 1); // l'état nul est un point fixe du xorshift
+}
+
+/** 
+ * rnd16(): tirage brut sur 16 bits
+ */
+unsigned int rnd16() {
+    unsigned short s = rnd_state;
+
+    rnd_step(s);
+    rnd_state = s;
+    return s;
+}
+
+/** 
+ * rnd(uchar max) : renvoie un nombre aléatoire (entier positif) dans l'intervalle  [0...max[
+ *  arg max: borne supérieure délimitant l'intervalle des nombres aléatoires générés
+ *           (type unsigned char ==> valeur maxi : 255)
+ * Sans division: octet de poids fort du tirage x max, / 256
+ */
+uchar rnd(uchar max) {
+    unsigned short s = rnd_state;
+
+    rnd_step(s);
+    rnd_state = s;
+    return (uchar) (((unsigned int) (s >> 8) * max) >> 8);
+}
+
+/** 
+ * rnd_fill(buf, n, max): n tirages dans l'intervalle [0...max[ d'un bloc dans buf[]
+ * (mêmes valeurs que n appels à rnd(max), sans le coût d'un appel de fonction par tirage)
+ */
+void rnd_fill(uchar *buf, uchar n, uchar max) {
+    unsigned short s = rnd_state;
+
+    for(; n > 0; n--) {
+        rnd_step(s);
+        *buf++ = (uchar) (((unsigned int) (s >> 8) * max) >> 8);
+    }
+    rnd_state = s;
+}
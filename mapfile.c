@@ -0,0 +1,193 @@
+/**
+ *      CTextMovingMap - mapfile.c
+ *      ==========================
+ *
+ *      Option MAP_FILE: sauvegarde et chargement de la carte map[][] sur le support externe: niveau
+ *      préparé (STORE_DATA, lecture seule, voir host/mkworld -f map) ou partie sauvegardée (STORE_SAVE).
+ *
+ *      Format du fichier (entiers 16 bits, poids faible en premier; voir aussi host/mkworld -f map):
+ *      - en-tête de MAP_FILE_HEADER_SIZE octets: "MMD1" (format et version), largeur, hauteur,
+ *        graine de génération, point de départ du personnage (x, y)
+ *      - index des lignes: position dans le fichier de chaque ligne de la carte
+ *      - lignes de MAP_XSIZE/2 octets, au format de map[][] (2 cellules par octet)
+ *
+ *      L'en-tête seul suffit pour présenter une carte (map_file_info()). Le chargement recopie les
+ *      lignes telles quelles dans map[][], sans décodage par cellule: les lignes consécutives dans
+ *      le fichier sont lues d'un seul bloc, l'index permet de relire une ligne isolée. Un fichier
+ *      tronqué, un index hors du fichier ou une valeur de cellule inconnue (> V_HILL2, qui ferait
+ *      déborder les tables indexées par valeur) font rejeter le fichier.
+ */
+
+#include "movingmap.h"
+
+#ifdef MAP_FILE
+
+#ifndef HOST_BUILD
+#error "MAP_FILE: pas encore de support de stockage externe (disquette/cassette) sur Oric"
+#endif
+
+
+/* ================== CONSTANTES ================== */
+
+#define MAP_FILE_HEADER_SIZE 16
+#define MAP_FILE_INDEX       MAP_FILE_HEADER_SIZE                   // index des lignes
+#define MAP_FILE_ROWS        (MAP_FILE_INDEX + 2*MAP_YSIZE)         // 1ère ligne
+#define MAP_ROW_BYTES        (MAP_XSIZE/2)
+#define MAP_FILE_INDEX_CHUNK 16     // entrées de l'index lues à la fois
+
+
+/* ================== MACROS ================== */
+
+#define get16(addr)       ((uchar) (addr)[0] | ((unsigned int) (uchar) (addr)[1] << 8))
+#define put16(addr, v)    { (addr)[0] = (char) (v); (addr)[1] = (char) ((v) >> 8); }
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// entrées de l'index lues à la fois (voir MAP_FILE_INDEX_CHUNK)
+static char index_chunk[2*MAP_FILE_INDEX_CHUNK];
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/**
+ * map_file_info(file, info): lecture de l'en-tête seul du fichier file (STORE_DATA ou STORE_SAVE;
+ * aperçu de la carte, sans la charger); FALSE si le fichier est absent ou n'est pas une carte de
+ * ce format
+ */
+bool map_file_info(uchar file, map_info *info) {
+    char header[MAP_FILE_HEADER_SIZE];
+
+    if(!store_open(file) || !store_read(0, header, MAP_FILE_HEADER_SIZE)) return FALSE;
+    if(header[0] != 'M' || header[1] != 'M' || header[2] != 'D' || header[3] != '1') return FALSE;
+    info->width   = get16(header + 4);
+    info->height  = get16(header + 6);
+    info->seed    = get16(header + 8);
+    info->start.x = get16(header + 10);
+    info->start.y = get16(header + 12);
+    return TRUE;
+}
+
+/**
+ * index_valid(): toutes les entrées de l'index désignent une ligne entière placée après l'index,
+ * dans le fichier ouvert
+ */
+static bool index_valid() {
+    unsigned long size = store_size();
+    unsigned int offset;
+    uchar y, k, n;
+
+    for(y = 0; y < MAP_YSIZE; y += n) {
+        n = (MAP_YSIZE - y < MAP_FILE_INDEX_CHUNK) ? MAP_YSIZE - y : MAP_FILE_INDEX_CHUNK;
+        if(!store_read(MAP_FILE_INDEX + 2*y, index_chunk, 2*n)) return FALSE;
+        for(k = 0; k < n; k++) {
+            offset = get16(index_chunk + 2*k);
+            if(offset < MAP_FILE_ROWS || offset + (unsigned long) MAP_ROW_BYTES > size) return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * rows_read(offset, y, rows): lecture d'un bloc de rows lignes consécutives dans map[][] à partir
+ * de la ligne y; FALSE si la lecture est impossible ou si une cellule a une valeur inconnue
+ * (test des 2 quartets de chaque octet lu, la recopie reste d'un seul bloc)
+ */
+static bool rows_read(unsigned int offset, uchar y, uchar rows) {
+    uchar *addr = (uchar *) &map[y][0];
+    unsigned int k, length = rows*MAP_ROW_BYTES;
+
+    if(!store_read(offset, (char *) addr, length)) return FALSE;
+    for(k = 0; k < length; k++, addr++) {
+        if(*addr >= ((V_HILL2+1) << 4) || (*addr & 0x0F) > V_HILL2) return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * map_file_load(file, info): chargement de la carte du fichier file dans map[][] et de son en-tête;
+ * FALSE si le fichier est absent, ne correspond pas aux dimensions de map[][] ou est invalide
+ * (tronqué, index hors du fichier: carte inchangée; valeur de cellule inconnue: des lignes ont pu
+ * être recopiées, la carte est à régénérer par init_map())
+ */
+bool map_file_load(uchar file, map_info *info) {
+    char *entry = index_chunk;
+    unsigned int offset, run_offset = 0;
+    uchar y, run_y = 0, run_rows = 0;
+    uchar n = 0;
+#ifdef MAP_LAZY
+    uchar *done = &region_done[0][0];
+#endif
+
+    if(!map_file_info(file, info)) return FALSE;
+    if(info->width != MAP_XSIZE || info->height != MAP_YSIZE
+    || info->start.x >= MAP_XSIZE || info->start.y >= MAP_YSIZE) return FALSE;
+    if(!index_valid()) return FALSE;
+
+    init_cell_chars();
+    for(y = 0; y < MAP_YSIZE; y++, n--, entry += 2) {
+        if(n == 0) {
+            // entrées suivantes de l'index
+            n = (MAP_YSIZE - y < MAP_FILE_INDEX_CHUNK) ? MAP_YSIZE - y : MAP_FILE_INDEX_CHUNK;
+            if(!store_read(MAP_FILE_INDEX + 2*y, index_chunk, 2*n)) return FALSE;
+            entry = index_chunk;
+        }
+        offset = get16(entry);
+        if(run_rows > 0 && offset == run_offset + run_rows*MAP_ROW_BYTES) {
+            // suite du bloc de lignes consécutives
+            run_rows++;
+            continue;
+        }
+        if(run_rows > 0 && !rows_read(run_offset, run_y, run_rows)) return FALSE;
+        run_offset = offset;
+        run_y = y;
+        run_rows = 1;
+    }
+    if(!rows_read(run_offset, run_y, run_rows)) return FALSE;
+
+#ifdef MAP_LAZY
+    // toutes les régions sont là
+    for(y = 0; y < REGIONS_Y*REGIONS_X; y++) {
+        *done++ = 1;
+    }
+#endif
+    walk_plane_update(0, 0, MAP_YSIZE, MAP_XSIZE);
+    map_start = info->start;
+    return TRUE;
+}
+
+/**
+ * map_file_save(info): sauvegarde de la partie (STORE_SAVE, le niveau préparé n'est jamais
+ * écrasé): map[][] (lignes consécutives) avec l'en-tête info (dimensions remplacées par celles de
+ * map[][]); FALSE si le fichier ne peut être créé
+ */
+bool map_file_save(map_info *info) {
+    char header[MAP_FILE_HEADER_SIZE];
+    char entry[2];
+    uchar y;
+    unsigned int offset = MAP_FILE_ROWS;
+
+#ifdef MAP_LAZY
+    // régions jamais affichées: générées avant d'être sauvegardées
+    map_prepare(0, 0, MAP_YSIZE, MAP_XSIZE);
+#endif
+    if(!store_create(STORE_SAVE)) return FALSE;
+
+    for(y = 0; y < MAP_FILE_HEADER_SIZE; y++) header[y] = 0;
+    header[0] = 'M'; header[1] = 'M'; header[2] = 'D'; header[3] = '1';
+    put16(header + 4, MAP_XSIZE);
+    put16(header + 6, MAP_YSIZE);
+    put16(header + 8, info->seed);
+    put16(header + 10, info->start.x);
+    put16(header + 12, info->start.y);
+    store_write(0, header, MAP_FILE_HEADER_SIZE);
+
+    for(y = 0; y < MAP_YSIZE; y++, offset += MAP_ROW_BYTES) {
+        put16(entry, offset);
+        store_write(MAP_FILE_INDEX + 2*y, entry, 2);
+    }
+    store_write(MAP_FILE_ROWS, &map[0][0], MAP_YSIZE*MAP_ROW_BYTES);
+    return TRUE;
+}
+
+#endif /* MAP_FILE */
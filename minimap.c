@@ -0,0 +1,148 @@
+/**
+ *      CTextMovingMap - minimap.c
+ *      ==========================
+ * 
+ *      Mini-carte (option MINIMAP): vue d'ensemble de toute la carte à droite de la fenêtre, une case
+ *      par bloc de MINIMAP_BLOCK x MINIMAP_BLOCK cellules, qui affiche le terrain dominant du bloc
+ *      (le plus fréquent parmi V_WALL à V_HILL2; vide si le bloc ne contient que des cellules vides).
+ * 
+ *      La carte n'est parcourue qu'une fois, après init_map() (minimap_build()): ensuite les comptes
+ *      par bloc sont mis à jour cellule par cellule (minimap_cell_changed(), appelée par set_map_cell()),
+ *      et seule la case de la mini-carte dont le terrain dominant change est réaffichée.
+ *      À chaque déplacement, seules les cases quittée et atteinte par le marqueur du personnage sont
+ *      redessinées (minimap_player()).
+ */
+
+#include "movingmap.h"
+
+#ifdef MINIMAP
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// nombre de cellules de chaque terrain dans chaque bloc (indice V_xxx - 1, de V_WALL à V_HILL2)
+static uchar mm_counts[MINIMAP_YSIZE][MINIMAP_XSIZE][V_HILL2];
+
+// terrain dominant de chaque bloc (V_xxx), tel qu'affiché dans la mini-carte
+static uchar mm_dominant[MINIMAP_YSIZE][MINIMAP_XSIZE];
+
+// bloc sous le marqueur du personnage (mm_player_bx = 0xFF: pas encore affiché)
+static uchar mm_player_bx = 0xFF, mm_player_by;
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/** 
+ * block_dominant(counts): terrain le plus fréquent d'un bloc (le premier en cas d'égalité),
+ * V_EMPTY si le bloc ne contient aucune cellule non vide
+ */
+static uchar block_dominant(uchar *counts) {
+    uchar v, best = 0, dominant = V_EMPTY;
+
+    for(v = V_WALL; v <= V_HILL2; v++, counts++) {
+        if(*counts > best) {
+            best = *counts;
+            dominant = v;
+        }
+    }
+    return dominant;
+}
+
+/** 
+ * minimap_build(): comptes de tous les blocs, en un seul parcours de la carte (2 cellules par octet,
+ * toujours dans le même bloc puisque MINIMAP_BLOCK est pair)
+ */
+void minimap_build() {
+    uchar y, x, v, i, j;
+    char *cell_addr = &map[0][0];
+    uchar *counts = &mm_counts[0][0][0];
+    uchar *dominant = &mm_dominant[0][0];
+
+    for(i = 0; i < MINIMAP_YSIZE; i++) {
+        for(j = 0; j < MINIMAP_XSIZE*V_HILL2; j++) {
+            *counts++ = 0;
+        }
+    }
+
+    for(y = 0; y < MAP_YSIZE; y++) {
+        for(x = 0; x < MAP_XSIZE; x += 2) {
+            counts = mm_counts[y >> MINIMAP_SHIFT][x >> MINIMAP_SHIFT];
+            v = get_high_quartet(*cell_addr);
+            if(v != V_EMPTY) counts[v-1]++;
+            v = get_low_quartet(*cell_addr);
+            if(v != V_EMPTY) counts[v-1]++;
+            cell_addr++;
+        }
+    }
+
+    counts = &mm_counts[0][0][0];
+    for(i = 0; i < MINIMAP_YSIZE; i++) {
+        for(j = 0; j < MINIMAP_XSIZE; j++) {
+            *dominant++ = block_dominant(counts);
+            counts += V_HILL2;
+        }
+    }
+}
+
+/** 
+ * minimap_draw(): affichage complet de la mini-carte (sans le marqueur du personnage, qui sera
+ * affiché par le prochain appel de minimap_player())
+ */
+void minimap_draw() {
+    uchar i, j;
+    char *addr = MINIMAP_ADDR;
+    uchar *dominant = &mm_dominant[0][0];
+
+    for(i = 0; i < MINIMAP_YSIZE; i++) {
+        for(j = 0; j < MINIMAP_XSIZE; j++) {
+            *addr++ = get_cvalue(*dominant++);
+        }
+        addr += SCREEN_WIDTH - MINIMAP_XSIZE;
+    }
+    count_writes(MINIMAP_XSIZE*MINIMAP_YSIZE);
+    mm_player_bx = 0xFF;
+}
+
+/** 
+ * minimap_cell_changed(y, x, old_v, new_v): la cellule (y, x) passe de la valeur old_v à new_v:
+ * mise à jour des comptes de son bloc, et de la case de la mini-carte si le terrain dominant change
+ * (sauf si elle est sous le marqueur du personnage)
+ */
+void minimap_cell_changed(coord y, coord x, uchar old_v, uchar new_v) {
+    uchar by = y >> MINIMAP_SHIFT, bx = x >> MINIMAP_SHIFT;
+    uchar *counts = mm_counts[by][bx];
+    uchar dominant;
+
+    if(old_v != V_EMPTY) counts[old_v-1]--;
+    if(new_v != V_EMPTY) counts[new_v-1]++;
+
+    dominant = block_dominant(counts);
+    if(dominant != mm_dominant[by][bx]) {
+        mm_dominant[by][bx] = dominant;
+        if(bx != mm_player_bx || by != mm_player_by) {
+            MINIMAP_ADDR[by*SCREEN_WIDTH + bx] = get_cvalue(dominant);
+            count_writes(1);
+        }
+    }
+}
+
+/** 
+ * minimap_player(y, x): marqueur du personnage sur le bloc de la cellule (y, x); rien à faire s'il
+ * n'a pas changé de bloc, sinon seules la case quittée et la case atteinte sont réaffichées
+ */
+void minimap_player(coord y, coord x) {
+    uchar by = y >> MINIMAP_SHIFT, bx = x >> MINIMAP_SHIFT;
+
+    if(bx == mm_player_bx && by == mm_player_by) return;
+
+    if(mm_player_bx != 0xFF) {
+        MINIMAP_ADDR[mm_player_by*SCREEN_WIDTH + mm_player_bx] = get_cvalue(mm_dominant[mm_player_by][mm_player_bx]);
+        count_writes(1);
+    }
+    MINIMAP_ADDR[by*SCREEN_WIDTH + bx] = C_PLAYER;
+    count_writes(1);
+    mm_player_bx = bx;
+    mm_player_by = by;
+}
+
+#endif /* MINIMAP */
@@ -0,0 +1,803 @@
+/**
+ *      CTextMovingMap - movingmap.h
+ *      ============================
+ * 
+ *      Types, constantes, macros et prototypes communs à tous les modules du moteur de carte
+ *      (map.c, mapfile.c, tiles.c, rle.c, render.c, minimap.c, path.c, entity.c, fov.c, hud.c, input.c,
+ *      stats.c, trace.c, play.c) et au programme principal (main.c)
+ */
+
+#ifndef MOVINGMAP_H
+#define MOVINGMAP_H
+
+
+/* ================== TYPES ================== */
+typedef unsigned char uchar;
+typedef unsigned char bool; // boolean
+
+
+/* ================== PLATEFORME ================== */
+// Ecran TEXT, clavier, curseur, cls()/paper()/ink(): Oric ou simulation "hôte" (voir platform.h)
+#include "platform.h"
+
+
+/* ================== CONSTANTES ================== */
+
+#ifndef NULL
+#define NULL ((void *) 0)
+#endif
+
+#ifndef FALSE
+#define FALSE ((bool) 0)
+#define TRUE  (!FALSE)
+#endif
+
+// Dimensions X et Y de la fenêtre d'affichage (modifiables à la compilation, ex. -DWIN_XSIZE=20;
+// avec BLIT_GEN, régénérer ensuite blit_gen.c)
+#ifndef WIN_XSIZE
+#ifdef MINIMAP
+#define WIN_XSIZE  19 // place pour la mini-carte à droite de la fenêtre
+#else
+#define WIN_XSIZE  30
+#endif
+#endif
+#ifndef WIN_YSIZE
+#define WIN_YSIZE  15
+#endif
+
+// Coordonnées du coin supérieur gauche de la fenêtre d'affichage
+#define WX  5
+#define WY  5
+
+// Mode de présentation des frames:
+// - par défaut (mode "économe en mémoire"): la carte, le personnage et les infos sont dessinés
+//   directement dans l'écran TEXT, pendant son affichage
+// - DOUBLE_BUFFER: tout est composé dans un tampon hors écran (back_buffer[], lignes PRESENT_FIRST_ROW
+//   à PRESENT_LAST_ROW de l'écran), puis recopié d'un bloc dans l'écran par present_frame(), après
+//   attente du "tic" d'affichage (wait_vsync()) => plus d'images partielles pendant les défilements
+//   (coût: (WIN_YSIZE+3)*SCREEN_WIDTH octets de RAM)
+//#define DOUBLE_BUFFER
+
+#define PRESENT_FIRST_ROW (WY-2)        // 1ère ligne d'infos
+#define PRESENT_LAST_ROW  (WY+WIN_YSIZE) // dernière ligne de la partie visible de la carte
+#define PRESENT_ROWS      (PRESENT_LAST_ROW - PRESENT_FIRST_ROW + 1)
+
+// Adresse de la ligne n° row de l'écran dans la "cible" de l'affichage (écran ou tampon)
+#ifdef DOUBLE_BUFFER
+#define DRAW_ROW_ADDR(row) (back_buffer + ((row) - PRESENT_FIRST_ROW)*SCREEN_WIDTH)
+#else
+#define DRAW_ROW_ADDR(row) ((char *) (TEXT_SCREEN + (row)*SCREEN_WIDTH))
+#endif
+
+// Adresse écran de la 1ère case (coin supérieur gauche) de la partie visible de la carte
+#define WIN_ADDR (DRAW_ROW_ADDR(WY+1) + WX+1)
+
+// Adresses des 2 lignes d'infos (coordonnées du personnage) au-dessus de la fenêtre
+#define ADDR_INFOLINE1 (DRAW_ROW_ADDR(WY-2) + WX+2)
+#define ADDR_INFOLINE2 (ADDR_INFOLINE1 + SCREEN_WIDTH)
+
+// Champs numériques des lignes d'infos (voir hud.c)
+#define HUD_X   0
+#define HUD_PX  1
+#define HUD_Y   2
+#define HUD_PY  3
+#define HUD_XV  4
+#define HUD_YV  5
+#define HUD_NB_FIELDS   6
+
+// réaffichage d'un champ uniquement si sa valeur a changé depuis la dernière frame
+#define hud_update(field, value) { if((value) != hud_values[field]) hud_draw_field(field, value); }
+
+// Affichage de la carte par des routines entièrement déroulées pour la géométrie de la fenêtre,
+// générées par host/mkblit dans blit_gen.c (make blit): une variante pour xv pair, une pour xv impair,
+// adresses écran et pas de la carte constants (coût: quelques Ko de code)
+//#define BLIT_GEN
+
+// Affichage d'une ligne de la fenêtre et test des déplacements possibles en assembleur 6502
+// (blit.s, à ajouter à OSDKFILE): compilation OSDK et mode MAP_DENSE uniquement. L'équivalence
+// avec la version C se vérifie dans l'émulateur du profileur (make asm-check, voir Makefile)
+//#define BLIT_ASM
+
+// Mode de stockage de la carte:
+// - par défaut (MAP_DENSE): tableau map[][] entièrement en RAM (2 cellules par octet), coordonnées
+//   sur 8 bits
+// - MAP_TILED: monde découpé en tuiles de TILE_SIZE x TILE_SIZE cellules (même compactage 2 cellules
+//   par octet), lues à la demande sur un support externe et gardées dans un cache LRU de
+//   TILE_CACHE_SLOTS tuiles (voir tiles.c); coordonnées sur 16 bits
+// - MAP_RLE: carte compressée ligne par ligne (suites de cellules identiques) avec un index des
+//   débuts de lignes, affichée directement depuis sa forme compressée (voir rle.c); coordonnées
+//   sur 16 bits
+//#define MAP_TILED
+//#define MAP_RLE
+
+#if defined(MAP_TILED) && defined(MAP_RLE)
+#error "MAP_TILED et MAP_RLE sont incompatibles"
+#endif
+
+#if defined(MAP_TILED) || defined(MAP_RLE)
+
+typedef unsigned int coord; // coordonnées dans la carte (16 bits)
+
+// nombre maxi de chiffres d'une coordonnée dans la carte
+#define HUD_COORD_WIDTH 5
+
+#else
+
+#define MAP_DENSE
+
+typedef uchar coord; // coordonnées dans la carte (8 bits)
+
+// nombre maxi de chiffres d'une coordonnée dans la carte
+#define HUD_COORD_WIDTH 3
+
+#endif
+
+#ifdef BLIT_ASM
+#if defined(HOST_BUILD) || !defined(MAP_DENSE)
+#error "BLIT_ASM: compilation OSDK en mode MAP_DENSE uniquement"
+#endif
+#ifdef BLIT_GEN
+#error "BLIT_ASM et BLIT_GEN sont incompatibles"
+#endif
+#endif
+
+#if defined(MAP_TILED)
+
+// Dimensions X et Y de la carte (multiples de TILE_SIZE)
+#define MAP_XSIZE   1024
+#define MAP_YSIZE   1024
+
+#define TILE_SIZE        16 // côté d'une tuile, en cellules (puissance de 2)
+#define TILE_SHIFT       4  // log2(TILE_SIZE)
+#define TILE_CACHE_SLOTS 16 // nombre de tuiles gardées en RAM (TILE_SIZE*TILE_SIZE/2 octets chacune)
+
+#elif defined(MAP_RLE)
+
+// Dimensions X et Y de la carte (doivent correspondre aux données générées par host/mkworld -f rle)
+#define MAP_XSIZE   320
+#define MAP_YSIZE   320
+
+#else
+
+// Dimensions X et Y de la carte
+#define MAP_XSIZE   100
+#define MAP_YSIZE   100
+
+#endif
+
+// Génération paresseuse (MAP_LAZY, mode MAP_DENSE uniquement): la carte n'est pas générée au
+// démarrage mais par régions de REGION_SIZE x REGION_SIZE cellules, chacune à partir de la graine
+// et de ses coordonnées, la première fois qu'elle est affichée ou testée (voir generate_region());
+// le démarrage ne dépend plus de la taille de la carte
+//#define MAP_LAZY
+
+#ifdef MAP_LAZY
+
+#ifndef MAP_DENSE
+#error "MAP_LAZY ne s'applique qu'au mode MAP_DENSE"
+#endif
+
+#define REGION_SIZE  16 // côté d'une région, en cellules (puissance de 2)
+#define REGION_SHIFT 4  // log2(REGION_SIZE)
+#define REGIONS_X    ((MAP_XSIZE + REGION_SIZE-1) >> REGION_SHIFT)
+#define REGIONS_Y    ((MAP_YSIZE + REGION_SIZE-1) >> REGION_SHIFT)
+
+#endif
+
+// Mini-carte (MINIMAP, mode MAP_DENSE sans MAP_LAZY): vue d'ensemble de toute la carte à droite de
+// la fenêtre, une case par bloc de MINIMAP_BLOCK x MINIMAP_BLOCK cellules affichant le terrain
+// dominant du bloc; les comptes par bloc sont tenus à jour à chaque modification de cellule
+// (set_map_cell()), sans jamais reparcourir la carte (voir minimap.c)
+//#define MINIMAP
+
+#ifdef MINIMAP
+
+#if !defined(MAP_DENSE) || defined(MAP_LAZY)
+#error "MINIMAP: mode MAP_DENSE (sans MAP_LAZY) uniquement"
+#endif
+
+#define MINIMAP_SHIFT 3  // log2(MINIMAP_BLOCK)
+#define MINIMAP_BLOCK (1 << MINIMAP_SHIFT) // côté d'un bloc, en cellules (puissance de 2, paire)
+#define MINIMAP_XSIZE ((MAP_XSIZE + MINIMAP_BLOCK-1) >> MINIMAP_SHIFT)
+#define MINIMAP_YSIZE ((MAP_YSIZE + MINIMAP_BLOCK-1) >> MINIMAP_SHIFT)
+
+// coin supérieur gauche de la mini-carte dans l'écran (dans les lignes de la fenêtre, pour DOUBLE_BUFFER)
+#define MINIMAP_X (SCREEN_WIDTH - MINIMAP_XSIZE)
+#define MINIMAP_Y (WY+1)
+#define MINIMAP_ADDR (DRAW_ROW_ADDR(MINIMAP_Y) + MINIMAP_X)
+
+#if WX + WIN_XSIZE + 2 > MINIMAP_X || MINIMAP_Y + MINIMAP_YSIZE - 1 > PRESENT_LAST_ROW
+#error "MINIMAP: pas de place pour la mini-carte à droite de la fenêtre (réduire WIN_XSIZE)"
+#endif
+
+#endif
+
+// Recherche de chemins (PATHFIND, mode MAP_DENSE): parcours en largeur et A* incrémentaux sur le
+// plan de praticabilité, mémoire bornée (voir path.c); dans play_map(), ESPACE ramène le
+// personnage à son point de départ, une tranche de recherche de PATH_STEP_BUDGET cellules par frame
+//#define PATHFIND
+
+#ifdef PATHFIND
+
+#ifndef MAP_DENSE
+#error "PATHFIND: mode MAP_DENSE uniquement"
+#endif
+
+#define PATH_STEP_BUDGET 64
+
+// état d'une recherche (voir path_step())
+#define PATH_IDLE     0
+#define PATH_RUNNING  1
+#define PATH_DONE     2
+#define PATH_NONE     3
+#define PATH_OVERFLOW 4
+
+#endif
+
+// Brouillard de guerre (FOG, mode MAP_DENSE): champ de vision du personnage dans un rayon de
+// FOV_RADIUS cases, arrêté par les terrains opaques (OPAQUE_VALUES); les cases déjà vues sont
+// mémorisées dans un plan "exploré" (1 bit par cellule), les autres sont affichées en C_FOG, et les
+// entités ne sont affichées que dans le champ de vision (voir fov.c)
+//#define FOG
+
+#ifdef FOG
+
+#ifndef MAP_DENSE
+#error "FOG: mode MAP_DENSE uniquement"
+#endif
+
+#ifndef FOV_RADIUS
+#define FOV_RADIUS 7
+#endif
+#define FOV_SIZE   (2*FOV_RADIUS + 1)        // côté du carré du champ de vision
+#define FOV_BYTES  ((FOV_SIZE + 7) >> 3)     // octets d'une ligne de ce carré (1 bit par case)
+#define FOV_CELLS_MAX ((FOV_RADIUS+1)*(FOV_RADIUS+2)/2)  // cases d'un octant
+
+#if MAP_XSIZE > 256 - FOV_RADIUS || MAP_YSIZE > 256 - FOV_RADIUS
+#error "FOG: coordonnees sur 8 bits, carte trop grande pour FOV_RADIUS"
+#endif
+
+#endif
+
+// Sauvegarde de la carte (MAP_FILE, mode MAP_DENSE): fichier binaire versionné sur le support
+// externe (en-tête, index des lignes, lignes de map[][] telles quelles, voir mapfile.c). Au
+// démarrage, la carte est chargée si le fichier existe (niveau préparé par host/mkworld -f map, ou
+// partie précédente), sinon générée; elle est sauvegardée avec la position du personnage en fin
+// de partie
+//#define MAP_FILE
+
+#if defined(MAP_FILE) && !defined(MAP_DENSE)
+#error "MAP_FILE: mode MAP_DENSE uniquement"
+#endif
+
+// Mesure des étapes d'une frame (FRAME_STATS): durée de chaque étape STAGE_xxx de play_map(), en µs
+// (timer 2 du VIA sur Oric, horloge monotone du PC), min / moyenne / max sur les STATS_FRAMES
+// dernières frames, affichés sur la ligne STATS_ROW de l'écran (une étape à la fois, voir stats.c).
+// Sans FRAME_STATS, les appels stats_xxx() disparaissent à la compilation
+//#define FRAME_STATS
+
+#define STAGE_INPUT   0     // attente et traitement du clavier (déplacements, voyage PATHFIND)
+#define STAGE_VIEW    1     // calcul de la frame: entités, champ de vision, parties visibles
+#define STAGE_BLIT    2     // affichage de la carte: décalages, lignes / colonnes décodées
+#define STAGE_PLAYER  3     // effacement et affichage des personnages et entités, mini-carte
+#define STAGE_HUD     4     // lignes d'infos et présentation de la frame (DOUBLE_BUFFER)
+#define STAGE_COUNT   5
+
+#define STATS_SHIFT   4     // log2(STATS_FRAMES)
+#define STATS_FRAMES  (1 << STATS_SHIFT)
+#define STATS_MAX     0xFFFF  // durée maxi mesurée (au-delà, la durée affichée est saturée)
+#define STATS_ROW     (SCREEN_HEIGHT-3) // sous les instructions de la fenêtre
+
+// Traces de parties (INPUT_TRACE): enregistrement de la graine et de chaque événement clavier
+// accepté par play_map(), avec son n° de frame (1 octet par événement en général), et sommes de
+// contrôle de la fenêtre à l'écran toutes les trace_every frames; une trace rejouée redonne
+// exactement la même partie, chaque somme de contrôle est comparée (voir trace.c et host/replay.c)
+//#define INPUT_TRACE
+
+#define TRACE_OFF     0
+#define TRACE_RECORD  1
+#define TRACE_REPLAY  2
+
+#ifndef TRACE_MAX_EVENTS
+#define TRACE_MAX_EVENTS 2048   // octets d'événements enregistrés au plus
+#endif
+#ifndef TRACE_MAX_SUMS
+#define TRACE_MAX_SUMS   128    // sommes de contrôle enregistrées au plus
+#endif
+#define TRACE_EVERY      16     // frames entre 2 sommes de contrôle (par défaut)
+
+// graine du générateur de la carte (voir init_map() et rnd_seed()): une graine = une carte
+#ifndef MAP_SEED
+#define MAP_SEED    1
+#endif
+
+// Divisions et multiplications entières par multiples de 2
+// en utilisant des opérations de décalage de bits
+// NB: ces macros  n'ont d'intérêt que sur des arguments qui sont des VARIABLES
+//     En effet les calculs sur des littéraux ou des constantes déclarées par #define
+//     sont normalement effectués dès la compilation pour simplifier la valeur
+//     des expressions (à confirmer peut-être pour lcc ??)
+//     
+#define div2(x) ((x) >> 1)
+#define div4(x) ((x) >> 2)
+#define div8(x) ((x) >> 3)
+#define mul2(x) ((x) << 1)
+#define mul4(x) ((x) << 2)
+#define mul8(x) ((x) << 3)
+
+
+
+
+// Caractères utilisés pour la carte, le joueur, et le contour de la fenêtre
+#define C_EMPTY ' '    // empty cell = SPACE = (uchar) 32
+#define C_WALL  '#'
+#define C_TREE  '^'
+#define C_WATER  '%'
+#define C_HILL1  '/'
+#define C_HILL2  '\\'  // Rappel: en C il faut doubler le caractère antislash, qui est sinoninterprété
+                       // comme un caractère 'escape' introduisant une séquence de contrôle (ex: '\n')
+#define C_PLAYER '*'
+#define C_WANDERER '&'
+#define C_GUARD    '$'
+#define C_CHECKERBOARD ((char) 126) // caractère 'damier'
+#define C_FOG      ':'  // case jamais vue (FOG)
+
+
+// Valeurs de chaque type de case, sur 4 bits maxi (donc 16 valeurs max possibles, de 0 à 15)
+#define V_EMPTY ((char) 0)
+#define V_WALL  ((char) 1)
+#define V_TREE  ((char) 2)
+#define V_WATER ((char) 3)
+#define V_HILL1 ((char) 4)
+#define V_HILL2 ((char) 5)
+
+// tableau indexé des caractères C_xxx correspondant aux constantes V_xxx (indexé par constantes V_xxx)
+// (défini dans map.c)
+extern char c_values[];
+
+#define get_cvalue(v_value) (c_values[v_value])
+
+// déterminer si un nombre (n° de case) est pair ou impair: il suffit juste de tester le bit 0 du nombre...
+#define is_even(x) (((x) & 1) == 0)
+#define is_odd(x)  (((x) & 1) != 0)
+
+// Manipulation des quartets d'une cellule
+// Le quartet supérieur ("poids fort") représentera TOUJOURS une cellule de n° PAIR
+// Le quartet inférieur ("poids faible") représentera TOUJOURS une cellule de n° IMPAIR
+#define get_high_quartet(val)  (((val) & 0xF0) >> 4)
+#define get_low_quartet(val)    ((val) & 0x0F)
+
+// renvoie le quartet de la valeur correspondant au  n° de cellule (quartet inférieur ou supérieur selon si le N° est impair ou pair)
+#define get_cellvalue(x, val) (is_odd(x) ?  get_low_quartet(val) :  get_high_quartet(val))
+
+#ifndef MAP_DENSE
+
+// accès aux cellules via le cache de tuiles (tiles.c) ou la carte compressée (rle.c)
+#define get_map_cell_value(y,x) map_cell_value(y, x)
+#define get_map_cell_char(y,x)  get_cvalue(map_cell_value(y, x))
+
+#else
+
+#define map_cell_quartet(y,x) (is_odd(x) ?  \
+                                     get_low_quartet(map[y][div2(x)])  \
+                                  :  get_high_quartet(map[y][div2(x)]))
+
+#ifdef MAP_LAZY
+// génération de la région de la cellule (y, x) si ce n'est pas encore fait
+#define map_region_ready(y,x) (region_done[(y) >> REGION_SHIFT][(x) >> REGION_SHIFT]  \
+                                  || generate_region((y) >> REGION_SHIFT, (x) >> REGION_SHIFT))
+
+// test de collision: la cellule peut être hors de la partie déjà affichée
+#define get_map_cell_value(y,x) (map_region_ready(y,x) ? map_cell_quartet(y,x) : V_EMPTY)
+#else
+#define get_map_cell_value(y,x) map_cell_quartet(y,x)
+#endif
+
+// caractère à afficher pour la cellule (y, x) de la carte (via les tables de décodage, voir map.c)
+// (MAP_LAZY: uniquement pour une cellule déjà affichée, donc déjà générée)
+#define get_map_cell_char(y,x) (is_odd(x) ?  \
+                                      cell_char_odd[(uchar) map[y][div2(x)]]  \
+                                   :  cell_char_even[(uchar) map[y][div2(x)]])
+
+// adresse de l'octet contenant la cellule (y, x), les suivants de la ligne étant contigus
+#define map_row_span(y,x,width) (&map[y][div2(x)])
+
+#endif /* MAP_DENSE */
+
+// pour affecter une double valeur, on passera TOUJOUTS les quartets dans l'ordre (SUPERIEUR, INFERIEUR)
+// pour correspondre à l'ordre des cases (1ere case PAIRE? 2e case IMPAIRE)
+#define combine_cellvalues(highval, lowval)    ((highval << 4) | lowval)
+#define set_cellvalues(addr, highval, lowval)  ((*addr) = combine_cellvalues(highval, lowval))
+
+// Classes de terrain praticables: le bit n° v est à 1 si les cellules de valeur V_xxx = v sont
+// praticables (modifiable à la compilation: 0x01 = cellules vides seulement, par défaut;
+// ex. -DPASSABLE_VALUES=0x31 pour des collines franchissables)
+#ifndef PASSABLE_VALUES
+#define PASSABLE_VALUES 0x01
+#endif
+#define is_passable(v) ((PASSABLE_VALUES >> (v)) & 1)
+
+// Classes de terrain qui arrêtent la vue (FOG): même codage, murs, arbres et collines par défaut
+#ifndef OPAQUE_VALUES
+#define OPAQUE_VALUES 0x36
+#endif
+#define is_opaque(v) ((OPAQUE_VALUES >> (v)) & 1)
+
+#if defined(BLIT_ASM) && PASSABLE_VALUES != 0x01
+#error "BLIT_ASM: asm_walk_dirs (blit.s) ne teste que les cellules vides"
+#endif
+
+#ifdef MAP_DENSE
+
+// Plan de praticabilité (mode MAP_DENSE): 1 bit par cellule, à 1 si la cellule est praticable,
+// 8 cellules par octet (bit 7 = 1ère cellule, comme le quartet supérieur pour les cellules paires);
+// construit par init_map() (ou par région avec MAP_LAZY), tenu à jour par set_map_cell()
+#define WALK_PLANE_BYTES ((MAP_XSIZE + 7) >> 3)
+
+// test de la cellule (y, x) dans le plan de praticabilité: un seul test de bit
+#define walk_plane_test(y,x) (walk_plane[y][(x) >> 3] & walk_bit[(x) & 7])
+
+#ifdef MAP_LAZY
+#define map_walkable(y,x) (map_region_ready(y,x) && walk_plane_test(y,x))
+#else
+#define map_walkable(y,x) walk_plane_test(y,x)
+#endif
+
+#else
+
+#define map_walkable(y,x) is_passable(get_map_cell_value(y,x))
+
+#endif /* MAP_DENSE */
+
+// Déplacements possibles depuis une cellule: cellule voisine praticable (voir map_walk_dirs())
+#define WALK_LEFT  1
+#define WALK_RIGHT 2
+#define WALK_UP    4
+#define WALK_DOWN  8
+
+// Scan codes des touches du clavier
+#define KEY_LEFT  172
+#define KEY_RIGHT 188
+#define KEY_DOWN  180
+#define KEY_UP    156
+#define KEY_SPACE 132
+#define KEY_ESC   169
+
+#define NO_KEY 0x38 // NO KEY PRESSED
+
+// File d'événements clavier (voir input.c): INPUT_QUEUE_SIZE événements au plus (puissance de 2);
+// une touche tenue est répétée après INPUT_DELAY tics du compteur système (1/100 s sur Oric),
+// puis tous les INPUT_REPEAT tics (modifiables à la compilation)
+#define INPUT_QUEUE_SIZE 8
+#ifndef INPUT_DELAY
+#define INPUT_DELAY  25
+#endif
+#ifndef INPUT_REPEAT
+#define INPUT_REPEAT 8
+#endif
+
+// Fenêtres d'affichage (viewports, voir render_viewports()): nombre maxi de personnages affichés
+// dans les fenêtres, largeur maxi d'une fenêtre
+#define NB_PLAYERS_MAX  4
+#define VIEW_MAX_XSIZE  SCREEN_WIDTH
+
+// VIEW_SPLIT: la fenêtre est partagée en 2 fenêtres indépendantes séparées par une colonne:
+// à gauche le personnage, à droite son point de départ
+//#define VIEW_SPLIT
+#define VIEW_SPLIT_LEFT ((WIN_XSIZE-1)/2) // largeur de la fenêtre de gauche
+
+// partie de la carte décodée dans une fenêtre à la dernière passe d'affichage (voir viewport_update())
+#define VIEW_EXPOSED_NONE   0
+#define VIEW_EXPOSED_FULL   1
+#define VIEW_EXPOSED_ROW    2
+#define VIEW_EXPOSED_COLUMN 3
+
+// Entités (ENTITIES): jusqu'à ENT_MAX personnages non joueurs, chacun avec un comportement
+// (ENT_xxx), rangés par bandes de ENT_BUCKET_ROWS lignes de la carte pour ne parcourir que
+// ceux des lignes affichées (voir entity.c); placés au hasard autour du point de départ
+//#define ENTITIES
+
+#ifndef ENT_MAX
+#define ENT_MAX 32
+#endif
+#define ENT_NONE 0xFF   // pas d'entité (fin de liste, case libre)
+
+#define ENT_BUCKET_SHIFT 3  // log2(ENT_BUCKET_ROWS)
+#define ENT_BUCKET_ROWS  (1 << ENT_BUCKET_SHIFT)
+#define ENT_BUCKETS      ((MAP_YSIZE + ENT_BUCKET_ROWS-1) >> ENT_BUCKET_SHIFT)
+#define ENT_SPREAD       40 // côté du carré de placement autour du point de départ
+
+// comportements
+#define ENT_STATIC  0   // immobile
+#define ENT_WANDER  1   // marche au hasard
+#define ENT_PATROL  2   // va et vient horizontal
+
+// caractère affiché pour la case (y, x) de la carte: avec FOG, C_FOG si elle n'a jamais été vue
+#ifdef FOG
+#define fov_explored_test(y,x) (fov_explored[y][(x) >> 3] & walk_bit[(x) & 7])
+#define map_cell_char_shown(y,x) (fov_explored_test(y,x) ? get_map_cell_char(y, x) : C_FOG)
+
+// case (y, x) dans le champ de vision actuel (carré de FOV_SIZE cases centré sur (fov_y, fov_x))
+#define fov_visible(y,x) ((uchar) ((y) - fov_y + FOV_RADIUS) < FOV_SIZE          \
+                       && (uchar) ((x) - fov_x + FOV_RADIUS) < FOV_SIZE          \
+                       && (fov_vis[(uchar) ((y) - fov_y + FOV_RADIUS)][(uchar) ((x) - fov_x + FOV_RADIUS) >> 3]  \
+                           & walk_bit[(uchar) ((x) - fov_x + FOV_RADIUS) & 7]))
+#else
+#define map_cell_char_shown(y,x) get_map_cell_char(y, x)
+#endif
+
+// caractère à réafficher à la place d'un personnage qui quitte la case (y, x)
+#ifdef ENTITIES
+#define cell_char_under(y,x) entity_cell_char(y, x)
+#else
+#define cell_char_under(y,x) map_cell_char_shown(y, x)
+#endif
+
+
+/* ================== TYPES ================== */
+
+// position d'un personnage sur la carte
+typedef struct {
+    coord x, y;
+} position;
+
+// en-tête d'un fichier de carte (MAP_FILE): dimensions, graine de génération, point de départ
+typedef struct {
+    unsigned int width, height;
+    unsigned int seed;
+    position     start;
+} map_info;
+
+// fenêtre d'affichage d'une partie de la carte, centrée sur un personnage (sauf aux bords)
+typedef struct {
+    char     *addr;          // adresse (écran ou tampon) de la case du coin supérieur gauche
+    uchar     xsize, ysize;  // dimensions de la partie visible
+    position *follow;        // personnage suivi
+    coord     xv, yv;        // coin supérieur gauche de la partie visible de la carte
+    bool      dirty;         // affichage complet à faire (1ère frame)
+    uchar     exposed;       // partie décodée à la dernière passe (VIEW_EXPOSED_xxx)
+    uchar     exposed_at;    // n° (relatif) de la ligne ou de la colonne décodée
+} viewport;
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// Représentation de la carte, chaque case est un caractère (char)
+// BRANCHE "2_cells_per_byte": on regroupe 2 valeurs en 1 octet => dimension X du tableau = XSIZE/2
+// (condition: que XSIZE soit pair... ce qui simplifie aussi grandement tous les calculs)
+// (défini dans map.c; uniquement en mode MAP_DENSE)
+#ifdef MAP_DENSE
+extern char map[MAP_YSIZE][MAP_XSIZE/2];
+#endif
+
+#ifdef MAP_LAZY
+// région (ry, rx) de la carte déjà générée (défini dans map.c)
+extern uchar region_done[REGIONS_Y][REGIONS_X];
+#endif
+
+#ifdef MAP_DENSE
+// plan de praticabilité et masque du bit de la cellule x dans son octet: walk_bit[x & 7] (définis dans map.c)
+extern uchar walk_plane[MAP_YSIZE][WALK_PLANE_BYTES];
+extern uchar walk_bit[8];
+#endif
+
+// tables de décodage octet de la carte => caractère de la cellule paire / impaire (définies dans map.c)
+extern char cell_char_even[256];
+extern char cell_char_odd[256];
+
+// dernière valeur affichée de chaque champ des lignes d'infos (définie dans hud.c)
+extern coord hud_values[HUD_NB_FIELDS];
+
+#ifdef MAP_TILED
+// nombre de tuiles lues sur le support externe (défauts de cache, défini dans tiles.c)
+extern unsigned long tile_misses;
+#endif
+
+#ifdef MAP_RLE
+// carte compressée (générée par host/mkworld -f rle): début de chaque ligne dans map_rle_data[]
+extern unsigned int map_rle_rows[MAP_YSIZE+1];
+extern uchar        map_rle_data[];
+#endif
+
+#ifdef ENTITIES
+// entités, rangées par colonnes (définies dans entity.c)
+extern coord ent_x[ENT_MAX], ent_y[ENT_MAX];
+extern char  ent_glyph[ENT_MAX];
+extern uchar ent_behaviour[ENT_MAX];
+extern uchar ent_count;
+#endif
+
+#ifdef FOG
+// plan des cases déjà vues, champ de vision actuel et son centre (définis dans fov.c)
+extern uchar fov_explored[MAP_YSIZE][WALK_PLANE_BYTES];
+extern uchar fov_vis[FOV_SIZE][FOV_BYTES];
+extern coord fov_y, fov_x;
+#endif
+
+// point de départ du personnage (centre de la carte, ou lu dans le fichier de carte; défini dans map.c)
+extern position map_start;
+
+#ifdef FRAME_STATS
+// durée cumulée de chaque étape depuis stats_init(), en µs (définie dans stats.c)
+extern unsigned long stats_total[STAGE_COUNT];
+#endif
+
+#ifdef INPUT_TRACE
+// trace en cours d'enregistrement ou rejouée (définie dans trace.c): mode TRACE_xxx, graine de la
+// carte, événements codés, sommes de contrôle de la fenêtre, frames jouées, sommes différentes
+// de celles de la trace au rejeu (et n° de frame de la 1ère)
+extern uchar        trace_mode;
+extern unsigned int trace_seed;
+extern uchar        trace_every;
+extern uchar        trace_data[TRACE_MAX_EVENTS];
+extern unsigned int trace_length;
+extern unsigned int trace_sums[TRACE_MAX_SUMS];
+extern unsigned int trace_nb_sums;
+extern unsigned int trace_frames;
+extern unsigned int trace_errors, trace_error_frame;
+extern bool         trace_full;
+#endif
+
+#ifdef DOUBLE_BUFFER
+// tampon de composition des frames (défini dans render.c)
+extern char back_buffer[PRESENT_ROWS*SCREEN_WIDTH];
+#endif
+
+
+/* ================== DECLARATION DES FONCTIONS (PROTOTYPES) ================== */
+
+// map.c
+void  init_map();
+void  init_cell_chars();
+void  rnd_seed(unsigned int seed);
+uchar rnd(uchar max);
+void  rnd_fill(uchar *buf, uchar n, uchar max);
+unsigned int rnd16();
+#ifndef BLIT_ASM
+uchar map_walk_dirs(coord y, coord x);
+#endif
+#ifdef MAP_DENSE
+void  set_map_cell(coord y, coord x, uchar v);
+void  walk_plane_update(coord y, coord x, uchar h, uchar w);
+#endif
+#ifdef MAP_LAZY
+uchar generate_region(uchar ry, uchar rx);
+void  map_prepare(coord y, coord x, uchar h, uchar w);
+#endif
+
+#ifdef MAP_FILE
+// mapfile.c
+bool  map_file_info(uchar file, map_info *info);
+bool  map_file_load(uchar file, map_info *info);
+bool  map_file_save(map_info *info);
+#endif
+
+#ifdef MAP_TILED
+// tiles.c
+void  tile_cache_init();
+uchar map_cell_value(coord y, coord x);
+char *map_row_span(coord y, coord x, uchar width);
+#endif
+
+#ifdef MAP_RLE
+// rle.c
+uchar map_cell_value(coord y, coord x);
+void  rle_blit_row(char *addr, coord y, coord x, uchar n);
+#endif
+
+#ifdef BLIT_ASM
+// blit.s
+void  asm_blit_row(char *addr, char *cell_addr, coord xv);
+uchar asm_walk_dirs(char *cell_addr, coord x);
+#define map_walk_dirs(y,x) asm_walk_dirs(&map[y][div2(x)], x)
+#endif
+
+#ifdef BLIT_GEN
+// blit_gen.c (généré par host/mkblit)
+void  blit_row_even(char *addr, char *cell_addr);
+void  blit_row_odd(char *addr, char *cell_addr);
+#ifdef MAP_DENSE
+void  blit_window_even(char *cell_addr);
+void  blit_window_odd(char *cell_addr);
+#endif
+#endif
+
+// render.c
+void  display_window();
+void  blit_map_row(char *addr, char *cell_addr, coord xv, uchar n);
+void  viewport_init(viewport *vp, char *addr, uchar xsize, uchar ysize, position *follow);
+void  render_viewports(viewport *views, uchar nb_views, position *players, uchar nb_players);
+void  draw_map_full(viewport *vp);
+void  draw_map_row(viewport *vp, uchar row);
+void  draw_map_column(viewport *vp, uchar col);
+void  scroll_view_down(viewport *vp);
+void  scroll_view_up(viewport *vp);
+void  scroll_view_right(viewport *vp);
+void  scroll_view_left(viewport *vp);
+#ifdef DOUBLE_BUFFER
+void  present_init();
+void  present_frame();
+#endif
+
+#ifdef MINIMAP
+// minimap.c
+void  minimap_build();
+void  minimap_draw();
+void  minimap_cell_changed(coord y, coord x, uchar old_v, uchar new_v);
+void  minimap_player(coord y, coord x);
+#endif
+
+#ifdef PATHFIND
+// path.c
+void  path_start_flood(coord y, coord x);
+void  path_start_route(coord y, coord x, coord ty, coord tx);
+uchar path_step(unsigned int budget);
+uchar path_dir(coord y, coord x);
+unsigned int path_distance(coord y, coord x);
+#endif
+
+#ifdef ENTITIES
+// entity.c
+void  entities_init(coord y, coord x);
+uchar entity_add(coord y, coord x, char glyph, uchar behaviour);
+void  entity_move(uchar e, coord y, coord x);
+uchar entity_at(coord y, coord x);
+char  entity_cell_char(coord y, coord x);
+void  entities_update();
+void  entities_erase_moved(viewport *vp);
+void  entities_overlay(viewport *vp);
+void  entities_moved_clear();
+#ifdef FOG
+void  entities_redraw_area(viewport *vp, coord y0, coord y1, coord x0, coord x1);
+#endif
+#endif
+
+#ifdef FOG
+// fov.c
+void  fov_init();
+void  fov_invalidate();
+void  fov_update(coord y, coord x);
+void  fov_explore(coord y, coord x);
+void  fov_blit_row(char *addr, coord y, coord xv, uchar n);
+void  fov_redraw(viewport *vp);
+void  fov_changes_clear();
+#endif
+
+#ifdef FRAME_STATS
+// stats.c
+void  stats_init();
+void  stats_mark(uchar stage);
+void  stats_frame();
+#else
+// sans mesure: aucun code
+#define stats_init()
+#define stats_mark(stage)
+#define stats_frame()
+#endif
+
+#ifdef INPUT_TRACE
+// trace.c
+void  trace_start(uchar mode);
+void  trace_frame();
+void  trace_put(uchar key);
+uchar trace_get(bool wait);
+unsigned int window_checksum();
+#endif
+
+// hud.c
+void  hud_init();
+void  hud_draw_field(uchar field, coord value);
+
+// input.c
+void  input_poll();
+void  input_sample();
+uchar input_next();
+uchar input_wait();
+
+// play.c
+void  play_map();
+void  wait_spacekey();
+void  hide_cursor();
+void  show_cursor();
+
+#endif /* MOVINGMAP_H */
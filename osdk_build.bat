@@ -14,6 +14,12 @@ IF "%OSDK%"=="" GOTO ErCfg
 CALL osdk_config.bat
 
 
+::
+:: The unrolled blit routines (option BLIT_GEN) are the versioned blit_gen.c: after a change of
+:: the window size in movingmap.h, regenerate it on the host with "make blit" (see Makefile)
+::
+
+
 ::
 :: Launch the compilation of files
 ::
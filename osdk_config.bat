@@ -8,4 +8,7 @@ SET OSDKNAME=MovingMap
 :: Set OISDK Compilation option (-O2=standard optimization, -O3=aggressive optimization)
 SET OSDKCOMP=-O3
 ::
-SET OSDKFILE=main
+SET OSDKFILE=main map mapfile render blit_gen minimap path entity fov hud input stats trace play
+:: option MAP_RLE (movingmap.h): ajouter rle et la carte compressée générée par
+:: "host/mkworld -f rle -w 320 -h 320", ex: SET OSDKFILE=main map mapfile render blit_gen minimap path entity fov hud input stats trace play rle map_rle_data
+:: option BLIT_ASM (movingmap.h): ajouter le module assembleur blit (blit.s)
@@ -0,0 +1,227 @@
+/**
+ *      CTextMovingMap - path.c
+ *      =======================
+ * 
+ *      Recherche de chemins sur la carte (option PATHFIND, mode MAP_DENSE), à partir du plan de
+ *      praticabilité (walk_plane[][]):
+ *      - path_start_flood(y, x): parcours en largeur depuis une origine, sur toute la partie
+ *        accessible de la carte (champ de directions vers l'origine, distances par path_distance())
+ *      - path_start_route(y, x, ty, tx): A* de (ty, tx) vers (y, x), arrêté dès que (y, x) est
+ *        atteinte: la recherche part de la destination, les directions mènent donc de (y, x) à elle
+ * 
+ *      La recherche est incrémentale: path_step(budget) traite au plus budget cellules par appel
+ *      (une tranche par frame dans play_map(), sans bloquer le clavier).
+ * 
+ *      Mémoire bornée, sans allocation:
+ *      - 1 bit par cellule "dans la file" et 1 bit "déjà traitée" (même organisation que walk_plane[][])
+ *      - 2 bits par cellule pour la direction de la cellule voisine vers l'origine
+ *      - file ouverte à 2 compartiments de PATH_QUEUE_SIZE entrées de 2 octets (y, x et direction
+ *        regroupés sur 7+7+2 bits): sur la grille (coût 1 par case, heuristique
+ *        de Manhattan), une voisine a toujours le même f que la cellule traitée (elle se rapproche du
+ *        but) ou f+2: les 2 compartiments suffisent pour traiter les cellules dans l'ordre des f
+ *        (en largeur: distance d et d+1).
+ *        Une cellule déjà dans la file n'y est ajoutée à nouveau que si c'est avec un meilleur f
+ *        (A* uniquement: dans le compartiment en cours alors qu'elle attend dans le suivant); seule
+ *        sa première sortie de la file compte, c'est celle du meilleur chemin.
+ */
+
+#include "movingmap.h"
+
+#ifdef PATHFIND
+
+
+/* ================== CONSTANTES ================== */
+
+// direction de la voisine vers l'origine, sur 2 bits (indice de path_walk[])
+#define P_LEFT  0
+#define P_RIGHT 1
+#define P_UP    2
+#define P_DOWN  3
+
+// octets d'une ligne de directions (4 cellules par octet)
+#define PATH_PARENT_BYTES ((MAP_XSIZE + 3) >> 2)
+
+// entrées par compartiment de la file (puissance de 2)
+#define PATH_QUEUE_SIZE 512
+#define PATH_QUEUE_MASK (PATH_QUEUE_SIZE-1)
+
+// entrée de la file: cellule (y, x) et direction vers l'origine sur 16 bits
+#define path_entry(y, x, dir) (((unsigned int) (y) << 9) | ((unsigned int) (x) << 2) | (dir))
+
+#if MAP_XSIZE > 128 || MAP_YSIZE > 128
+#error "PATHFIND: coordonnées sur 7 bits dans la file (carte de 128x128 maxi)"
+#endif
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// cellules déjà ajoutées à la file, et déjà traitées (1 bit par cellule, masques walk_bit[])
+static uchar path_queued[MAP_YSIZE][WALK_PLANE_BYTES];
+static uchar path_closed[MAP_YSIZE][WALK_PLANE_BYTES];
+
+// direction vers l'origine de chaque cellule traitée (2 bits par cellule, la 1ère dans les bits 7-6)
+static uchar path_parent[MAP_YSIZE][PATH_PARENT_BYTES];
+static uchar parent_shift[4] = { 6, 4, 2, 0 };
+
+// bits WALK_xxx correspondant aux directions P_xxx
+static uchar path_walk[4] = { WALK_LEFT, WALK_RIGHT, WALK_UP, WALK_DOWN };
+
+// file ouverte: 2 compartiments (files circulaires), q_cur = compartiment en cours
+static unsigned int q_entries[2][PATH_QUEUE_SIZE];
+static unsigned int q_head[2], q_tail[2];
+static uchar q_cur;
+
+// état de la recherche (PATH_xxx), origine, et cible pour A*
+static uchar path_state = PATH_IDLE;
+static bool  path_astar;
+static coord path_oy, path_ox;
+static coord path_ty, path_tx;
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/** 
+ * path_push(y, x, dir, same): ajout de la cellule (y, x), atteinte depuis sa voisine dans la
+ * direction dir, au compartiment en cours (same: même f) ou au suivant; une cellule déjà dans
+ * la file n'est ajoutée à nouveau que dans le compartiment en cours
+ */
+static void path_push(coord y, coord x, uchar dir, bool same) {
+    uchar b = same ? q_cur : q_cur ^ 1;
+    unsigned int t = q_tail[b];
+    uchar *queued_addr = &path_queued[y][x >> 3];
+
+    if(*queued_addr & walk_bit[x & 7]) {
+        if(!same) return;
+    }
+    else {
+        *queued_addr |= walk_bit[x & 7];
+    }
+
+    if(((t+1) & PATH_QUEUE_MASK) == q_head[b]) {
+        path_state = PATH_OVERFLOW;
+        return;
+    }
+    q_entries[b][t] = path_entry(y, x, dir);
+    q_tail[b] = (t+1) & PATH_QUEUE_MASK;
+}
+
+/** 
+ * path_start(y, x): nouvelle recherche depuis l'origine (y, x): plus aucune cellule dans la file
+ * ni traitée, file réduite à l'origine
+ */
+static void path_start(coord y, coord x) {
+    unsigned int i;
+    uchar *queued_addr = &path_queued[0][0];
+    uchar *closed_addr = &path_closed[0][0];
+
+    for(i = 0; i < MAP_YSIZE*WALK_PLANE_BYTES; i++) {
+        *queued_addr++ = 0;
+        *closed_addr++ = 0;
+    }
+    q_head[0] = q_tail[0] = q_head[1] = q_tail[1] = 0;
+    q_cur = 0;
+    path_oy = y; path_ox = x;
+    path_state = PATH_RUNNING;
+    path_push(y, x, P_LEFT, TRUE);
+}
+
+/** 
+ * path_start_flood(y, x): parcours en largeur de la partie accessible de la carte depuis (y, x)
+ */
+void path_start_flood(coord y, coord x) {
+    path_astar = FALSE;
+    path_start(y, x);
+}
+
+/** 
+ * path_start_route(y, x, ty, tx): recherche A* d'un chemin de (y, x) à (ty, tx) (calculé depuis
+ * (ty, tx): path_dir() donne ensuite les déplacements à partir de (y, x)); pas de chemin si
+ * (ty, tx) n'est pas praticable
+ */
+void path_start_route(coord y, coord x, coord ty, coord tx) {
+    path_astar = TRUE;
+    path_ty = y; path_tx = x;
+    path_start(ty, tx);
+    if(!map_walkable(ty, tx)) path_state = PATH_NONE;
+}
+
+/** 
+ * path_step(budget): poursuite de la recherche en cours sur au plus budget cellules sorties de
+ * la file; renvoie son état: PATH_RUNNING (à poursuivre), PATH_DONE (chemin trouvé, ou parcours
+ * en largeur terminé), PATH_NONE (pas de chemin), PATH_OVERFLOW (file pleine)
+ */
+uchar path_step(unsigned int budget) {
+    uchar b, dir;
+    unsigned int e;
+    coord y, x;
+
+    for(; budget > 0 && path_state == PATH_RUNNING; budget--) {
+        b = q_cur;
+        if(q_head[b] == q_tail[b]) {
+            // compartiment vide: passage au suivant (f+2, ou distance+1 en largeur)
+            b ^= 1;
+            if(q_head[b] == q_tail[b]) {
+                path_state = path_astar ? PATH_NONE : PATH_DONE;
+                break;
+            }
+            q_cur = b;
+        }
+        e = q_entries[b][q_head[b]];
+        q_head[b] = (q_head[b]+1) & PATH_QUEUE_MASK;
+        y = e >> 9;
+        x = (e >> 2) & 0x7F;
+        dir = e & 3;
+
+        if(path_closed[y][x >> 3] & walk_bit[x & 7]) continue;
+        path_closed[y][x >> 3] |= walk_bit[x & 7];
+        path_parent[y][x >> 2] = (path_parent[y][x >> 2] & ~(3 << parent_shift[x & 3]))
+                               | (dir << parent_shift[x & 3]);
+
+        if(path_astar && y == path_ty && x == path_tx) {
+            path_state = PATH_DONE;
+            break;
+        }
+
+        // voisines praticables pas encore traitées (A*: même f si elle se rapproche de la cible)
+        if(x > 0 && map_walkable(y, x-1) && !(path_closed[y][(x-1) >> 3] & walk_bit[(x-1) & 7]))
+            path_push(y, x-1, P_RIGHT, path_astar && path_tx < x);
+        if(x < MAP_XSIZE-1 && map_walkable(y, x+1) && !(path_closed[y][(x+1) >> 3] & walk_bit[(x+1) & 7]))
+            path_push(y, x+1, P_LEFT, path_astar && path_tx > x);
+        if(y > 0 && map_walkable(y-1, x) && !(path_closed[y-1][x >> 3] & walk_bit[x & 7]))
+            path_push(y-1, x, P_DOWN, path_astar && path_ty < y);
+        if(y < MAP_YSIZE-1 && map_walkable(y+1, x) && !(path_closed[y+1][x >> 3] & walk_bit[x & 7]))
+            path_push(y+1, x, P_UP, path_astar && path_ty > y);
+    }
+    return path_state;
+}
+
+/** 
+ * path_dir(y, x): déplacement (bit WALK_xxx) qui rapproche la cellule (y, x) de l'origine de la
+ * recherche d'un pas; 0 si c'est l'origine ou si la cellule n'a pas été atteinte
+ */
+uchar path_dir(coord y, coord x) {
+    if(!(path_closed[y][x >> 3] & walk_bit[x & 7])) return 0;
+    if(y == path_oy && x == path_ox) return 0;
+    return path_walk[(path_parent[y][x >> 2] >> parent_shift[x & 3]) & 3];
+}
+
+/** 
+ * path_distance(y, x): nombre de pas de la cellule (y, x) à l'origine, en suivant les directions
+ * (0xFFFF si la cellule n'a pas été atteinte)
+ */
+unsigned int path_distance(coord y, coord x) {
+    unsigned int d = 0;
+    uchar dir;
+
+    if(!(path_closed[y][x >> 3] & walk_bit[x & 7])) return 0xFFFF;
+    while((dir = path_dir(y, x)) != 0) {
+        if(dir == WALK_LEFT)       x--;
+        else if(dir == WALK_RIGHT) x++;
+        else if(dir == WALK_UP)    y--;
+        else                       y++;
+        d++;
+    }
+    return d;
+}
+
+#endif /* PATHFIND */
@@ -0,0 +1,122 @@
+/**
+ *      CTextMovingMap - platform.h
+ *      ===========================
+ * 
+ *      Couche plateforme: tout ce qui dépend du matériel Oric est regroupé ici
+ *      - écran TEXT (adresse 0xBB80, 40x28 caractères)
+ *      - octet de la dernière touche pressée (0x208)
+ *      - drapeaux du curseur (0x26A, bit 0 = curseur visible)
+ *      - compteur système 100 Hz (0x276) et timer 2 du VIA (mesure des frames, FRAME_STATS)
+ *      - fonctions cls(), paper(), ink(), text(), gotoxy(), printf()
+ *      - count_writes(n): comptage des octets écrits par l'affichage (PC seulement, vide sur Oric)
+ *      - support de stockage externe du monde (mode MAP_TILED), du niveau et de la partie sauvegardée
+ *        (MAP_FILE): store_open(), store_read(), store_create(), store_write()
+ * 
+ *      Si HOST_BUILD est défini (compilation sur PC avec gcc, voir Makefile), ces éléments sont
+ *      simulés par host/platform_host.c: écran en RAM, clavier alimenté par un "script" de touches.
+ *      NB: ce fichier est inclus par movingmap.h, APRES la définition des types uchar et bool.
+ */
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+// Dimensions de l'écran
+#define SCREEN_WIDTH  40
+#define SCREEN_HEIGHT 28
+
+// fichiers du support de stockage externe (store_open(), store_create())
+#define STORE_DATA 0    // monde (MAP_TILED) ou niveau préparé (MAP_FILE), en lecture seule
+#define STORE_SAVE 1    // partie sauvegardée (MAP_FILE)
+
+#ifndef HOST_BUILD
+
+/* ================== ORIC (OSDK) ================== */
+
+#include <stdio.h>
+#include <sys/graphics.h>
+//#include <lib.h> // désativé, car définition de fonction rand() buggée ici
+
+// Adresse de début de l'écran TEXT
+#define TEXT_SCREEN 0xBB80
+
+// lecture de l'adresse contenant la dernière touche pressée du clavier; sample_key(): même lecture,
+// faite en cours d'affichage (voir input_sample())
+#define read_key()   (*((uchar *) 0x208))
+#define sample_key() read_key()
+
+// drapeaux du curseur (bit 0 = curseur visible)
+#define CURSOR_FLAGS (*((uchar *) 0x26A))
+
+// compteur décrémenté par l'interruption système (100 Hz) de la ROM
+#define SYS_TIMER_LO (*((volatile uchar *) 0x276))
+
+// timer 2 du VIA 6522 (1 MHz, non utilisé par la ROM en jeu): une fois lancé par timer_start(), il
+// décompte librement sur 16 bits, 1 unité = 1 µs (mesure des étapes des frames, FRAME_STATS)
+#define VIA_T2_LO (*((volatile uchar *) 0x308))
+#define VIA_T2_HI (*((volatile uchar *) 0x309))
+#define timer_start() { VIA_T2_LO = 0xFF; VIA_T2_HI = 0xFF; }
+
+// attente du prochain "tic" d'affichage: l'Oric n'a pas de signal de synchro verticale lisible
+// sans modification matérielle, on se cale donc sur l'interruption système
+#define wait_vsync() { uchar tick = SYS_TIMER_LO; while(SYS_TIMER_LO == tick) ; }
+
+// comptage des octets écrits dans l'écran ou le tampon de composition (banc de mesure PC): rien
+#define count_writes(n)
+
+#else
+
+/* ================== PC / HOTE (gcc) ================== */
+
+#include <stdio.h>
+
+// écran TEXT simulé en RAM (NB: TEXT_SCREEN est ici un pointeur et non une adresse entière,
+// mais les expressions du type (char *) (TEXT_SCREEN + offset) restent valides)
+extern char  host_text_screen[SCREEN_WIDTH*SCREEN_HEIGHT];
+extern uchar host_cursor_flags;
+
+#define TEXT_SCREEN  host_text_screen
+#define read_key()   host_read_key()
+// lecture en cours d'affichage: la touche du script que lira le prochain read_key(), sans avancer
+// dans le script ni compter de "tic" (les frames du banc de mesure restent délimitées par read_key())
+#define sample_key() host_sample_key()
+#define CURSOR_FLAGS host_cursor_flags
+
+// compteur système simulé: décrémenté à chaque lecture du clavier (un "tic" par lecture)
+extern uchar host_sys_timer;
+#define SYS_TIMER_LO host_sys_timer
+
+// compteur en µs décroissant (comme le timer 2 du VIA), lu sur l'horloge monotone du PC
+unsigned int host_timer_read();
+#define timer_start()
+
+// octets écrits dans l'écran ou le tampon de composition: chaque routine d'affichage ajoute le
+// nombre de caractères qu'elle écrit (qu'ils changent ou non l'écran), relevé par le banc de mesure
+extern unsigned long host_bytes_written;
+#define count_writes(n) (host_bytes_written += (n))
+
+// printf() écrit dans l'écran simulé, à la position du curseur (comme sur Oric)
+#define printf       host_printf
+
+// support de stockage externe (modes MAP_TILED, MAP_FILE): un fichier sur PC par fichier du support
+// (voir host_store_file, host_save_file); store_read() / store_write() portent sur le dernier ouvert
+// (store_read(): FALSE si la lecture est impossible, ex. fichier tronqué; store_size(): taille du
+// fichier ouvert)
+bool  store_open(uchar file);
+bool  store_read(unsigned long offset, char *buffer, unsigned int length);
+unsigned long store_size();
+bool  store_create(uchar file);
+void  store_write(unsigned long offset, char *buffer, unsigned int length);
+
+uchar host_read_key();
+uchar host_sample_key();
+int   host_printf(const char *format, ...);
+void  wait_vsync();
+void  text();
+void  cls();
+void  paper(uchar color);
+void  ink(uchar color);
+void  gotoxy(uchar x, uchar y);
+
+#endif /* HOST_BUILD */
+
+#endif /* PLATFORM_H */
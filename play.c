@@ -0,0 +1,246 @@
+/**
+ *      CTextMovingMap - play.c
+ *      =======================
+ * 
+ *      Boucle principale de déplacement sur la carte (play_map) et gestion du clavier/curseur
+ */
+
+#include "movingmap.h"
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/** 
+ * play_map(): affichage de la carte et boucle principale de gestion du clavier et des déplacements
+ * 
+ * v1.3: affichage incrémental. La carte n'est entièrement redessinée qu'à la 1ère frame (ou en cas
+ * de "saut" de la partie visible); ensuite:
+ * - si la partie visible ne bouge pas, seules les 2 cases concernées (ancienne et nouvelle
+ *   position du personnage) sont redessinées
+ * - si la partie visible se décale d'une case, le contenu de la fenêtre est décalé directement
+ *   dans la mémoire écran, et seule la ligne ou la colonne nouvellement visible est décodée
+ * 
+ * v1.6: en mode DOUBLE_BUFFER, la frame est composée dans back_buffer[] puis présentée d'un bloc
+ * v1.7: lignes d'infos à champs fixes, réaffichés seulement quand leur valeur change (hud.c)
+ * v1.13: les 4 déplacements possibles sont testés d'un seul appel (map_walk_dirs(), en C ou en
+ *        assembleur avec BLIT_ASM)
+ * v1.14: affichage par fenêtres indépendantes (render_viewports(), render.c): l'affichage
+ *        incrémental est fait par fenêtre; avec VIEW_SPLIT, 2 fenêtres côte à côte (le personnage
+ *        et son point de départ)
+ * v1.15: avec MINIMAP, marqueur du personnage sur la mini-carte (minimap_player())
+ * v1.17: avec PATHFIND, ESPACE ramène le personnage à son point de départ par le plus court
+ *        chemin, calculé par tranches (path_step()) sans bloquer le clavier
+ * v1.18: avec ENTITIES, les entités font un pas de comportement à chaque frame
+ * v1.19: clavier par file d'événements avec répétition (input.c): tous les déplacements en
+ *        attente sont appliqués avant un seul affichage, les frames intermédiaires sont sautées;
+ *        le clavier est aussi échantillonné entre les étapes de l'affichage (input_sample())
+ * v1.20: avec FOG, champ de vision recalculé quand le personnage se déplace, cases jamais vues
+ *        masquées; avec des déplacements regroupés, les positions intermédiaires explorent aussi
+ * v1.21: départ en map_start (centre de la carte, ou position chargée avec MAP_FILE); avec
+ *        MAP_FILE, la position finale y est notée pour la sauvegarde de la partie
+ * v1.22: avec FRAME_STATS, durée de chaque étape de la frame (stats_mark(), voir stats.c)
+ * v1.23: avec INPUT_TRACE, les événements clavier de chaque frame sont enregistrés ou rejoués
+ *        (trace_frame(), voir trace.c)
+ */
+void play_map() { 
+    position player;      // coordonnees ABSOLUES du personnage dans la map
+    position start;       // point de départ du personnage
+    uchar px,py;          // coordonnees RELATIVES du personnage dans la fenêtre d'affichage
+#ifdef VIEW_SPLIT
+    viewport views[2];
+#else
+    viewport views[1];
+#endif
+
+    uchar key = NO_KEY;
+    uchar walk;    // déplacements possibles (bits WALK_xxx)
+    bool end = FALSE;
+#ifdef PATHFIND
+    bool travel = FALSE; // retour automatique au point de départ en cours
+    uchar path_status;
+#endif
+#ifdef FOG
+    position seen;       // position du dernier calcul du champ de vision
+#endif
+
+    player = start = map_start;
+
+#ifdef VIEW_SPLIT
+    viewport_init(&views[0], WIN_ADDR, VIEW_SPLIT_LEFT, WIN_YSIZE, &player);
+    viewport_init(&views[1], WIN_ADDR + VIEW_SPLIT_LEFT+1, WIN_XSIZE - VIEW_SPLIT_LEFT-1, WIN_YSIZE, &start);
+#else
+    viewport_init(&views[0], WIN_ADDR, WIN_XSIZE, WIN_YSIZE, &player);
+#endif
+
+#ifdef ENTITIES
+    entities_init(start.y, start.x);
+#endif
+#ifdef FOG
+    fov_init();
+#endif
+
+#ifdef DOUBLE_BUFFER
+    // le tampon part du contenu actuel de l'écran (cadre de la fenêtre)
+    present_init();
+#endif
+    hud_init();
+#ifdef MINIMAP
+    minimap_draw();
+#endif
+    stats_init();
+
+    // Boucle principale:
+    // - affichage de la partie visible de la carte dans la (ou les) fenêtre(s)
+    // - gestion du clavier pour les déplacements et la 'fin de partie'
+    while(!end) {
+#ifdef FOG
+        // champ de vision du personnage (recalculé seulement s'il s'est déplacé)
+        fov_update(player.y, player.x);
+        seen = player;
+#endif
+        // Affichage incrémental des fenêtres, qui suivent chacune leur personnage, puis du personnage
+        render_viewports(views, sizeof(views)/sizeof(views[0]), &player, 1);
+#ifdef MINIMAP
+        minimap_player(player.y, player.x);
+#endif
+        stats_mark(STAGE_PLAYER);
+        input_sample();
+
+        // PX et PY sont les coordonnees relatives du personnage dans la 1ère fenêtre
+        px = player.x - views[0].xv;
+        py = player.y - views[0].yv;
+
+        // affichage infos coordonnées courantes du 'joueur' (seulement les champs modifiés)
+        hud_update(HUD_X, player.x);
+        hud_update(HUD_PX, px);
+        hud_update(HUD_Y, player.y);
+        hud_update(HUD_PY, py);
+        hud_update(HUD_XV, views[0].xv);
+        hud_update(HUD_YV, views[0].yv);
+
+#ifdef DOUBLE_BUFFER
+        // frame complète: recopie du tampon dans l'écran
+        present_frame();
+#endif
+        stats_mark(STAGE_HUD);
+        input_sample();
+#ifdef INPUT_TRACE
+        // frame affichée: somme de contrôle de la fenêtre (enregistrement ou rejeu d'une trace)
+        trace_frame();
+#endif
+
+        // Gestion du clavier pour les déplacements et la 'fin de partie'
+#ifdef PATHFIND
+        if(travel) {
+            // voyage en cours: le clavier est seulement consulté (une touche de déplacement ou ESC
+            // interrompt le voyage); une tranche de recherche par frame, puis un pas par frame
+            // sur le chemin trouvé
+            input_poll();
+            key = input_next();
+            if(key == KEY_SPACE) key = NO_KEY;
+            if(key != NO_KEY) {
+                travel = FALSE;
+            }
+            else {
+                path_status = path_step(PATH_STEP_BUDGET);
+                if(path_status == PATH_DONE) {
+                    walk = path_dir(player.y, player.x);
+                    if(walk == WALK_LEFT)       key = KEY_LEFT;
+                    else if(walk == WALK_RIGHT) key = KEY_RIGHT;
+                    else if(walk == WALK_UP)    key = KEY_UP;
+                    else if(walk == WALK_DOWN)  key = KEY_DOWN;
+                    else travel = FALSE; // arrivé
+                }
+                else if(path_status != PATH_RUNNING) {
+                    travel = FALSE; // pas de chemin (ou file pleine)
+                }
+            }
+        }
+        else
+#endif
+        key = input_wait();
+
+        // 1er événement, puis ceux déjà dans la file (répétitions rattrapées, touches pressées
+        // pendant l'affichage): tous appliqués avant la prochaine frame
+        do {
+#ifdef FOG
+            // déplacements regroupés: cases vues depuis la position intermédiaire explorées aussi
+            if(player.x != seen.x || player.y != seen.y) {
+                fov_explore(player.y, player.x);
+                seen = player;
+            }
+#endif
+            if(key == KEY_ESC) {
+                end = TRUE;
+            }
+#ifdef PATHFIND
+            else if(key == KEY_SPACE) {
+                // recherche du chemin du retour, poursuivie aux frames suivantes
+                path_start_route(player.y, player.x, start.y, start.x);
+                travel = TRUE;
+            }
+#endif
+            else {
+                // cellules voisines libres, testées d'un seul coup (C ou assembleur, voir map_walk_dirs())
+                walk = map_walk_dirs(player.y, player.x);
+                switch(key) {
+                    case KEY_LEFT:
+                        if(walk & WALK_LEFT) player.x--;
+                        break;
+                    case KEY_RIGHT:
+                        if(walk & WALK_RIGHT) player.x++;
+                        break;
+                    case KEY_UP:
+                        if(walk & WALK_UP) player.y--;
+                        break;
+                    case KEY_DOWN:
+                        if(walk & WALK_DOWN) player.y++;
+                        break;
+                }
+            }
+        } while(!end && (key = input_next()) != NO_KEY);
+        stats_mark(STAGE_INPUT);
+        stats_frame();
+
+#ifdef ENTITIES
+        // un pas de comportement des entités (seules celles qui bougent seront redessinées)
+        entities_update();
+#endif
+    }
+
+#ifdef MAP_FILE
+    // position finale: point de départ de la partie sauvegardée
+    map_start = player;
+#endif
+}
+
+/** 
+ * Attend une pression sur la touche ESPACE 
+ */
+void wait_spacekey() {
+    uchar key = NO_KEY;
+    // wait for space key pressed
+	for(; key != KEY_SPACE;) {
+		key = read_key();
+	}
+    // wait for key release
+	for(; key != NO_KEY;) {
+		key = read_key();
+	}
+}
+
+/**
+ * hide_cursor(): cache le curseur 
+ */ 
+void hide_cursor() {
+	// Hide the cursor: clear bit 0 @ 0x26A
+	CURSOR_FLAGS &= 0xFE;
+}
+
+/**
+ * hide_cursor(): montre le curseur 
+ */ 
+void show_cursor() {
+	// End game: show cursor: set bit 0 @ 0x26A
+	CURSOR_FLAGS |= 1;
+}
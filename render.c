@@ -0,0 +1,517 @@
+/**
+ *      CTextMovingMap - render.c
+ *      =========================
+ * 
+ *      Affichage de la fenêtre et de la partie visible de la carte dans l'écran TEXT:
+ *      affichage complet, ou incrémental (décalage du contenu + ligne/colonne nouvellement visible),
+ *      dans une ou plusieurs fenêtres indépendantes (viewports, voir render_viewports())
+ */
+
+#include "movingmap.h"
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+#ifdef DOUBLE_BUFFER
+// tampon de composition des frames: copie des lignes PRESENT_FIRST_ROW à PRESENT_LAST_ROW de l'écran
+char back_buffer[PRESENT_ROWS*SCREEN_WIDTH];
+#endif
+
+// fenêtres déjà mises à jour pendant la passe en cours de render_viewports(): leur contenu est
+// exactement la carte (personnages pas encore affichés), une ligne qu'elles montrent est donc
+// recopiée au lieu d'être décodée à nouveau (voir draw_map_row())
+static viewport *shared_views;
+static uchar     nb_shared_views;
+
+// personnages affichés à la passe précédente (cases de la carte à réafficher)
+static position  old_players[NB_PLAYERS_MAX];
+static uchar     old_nb_players;
+
+
+/* ================== MACROS ================== */
+
+// affichage à l'adresse addr des n cases de la ligne y de la carte à partir de la case xv:
+// la carte compressée (MAP_RLE) est décodée directement en caractères, les autres modes passent
+// par les octets de la carte (2 cellules par octet), avec FOG en testant aussi le plan exploré
+#ifdef MAP_RLE
+#define blit_map_line(addr, y, xv, n) rle_blit_row(addr, y, xv, n)
+#elif defined(FOG)
+#define blit_map_line(addr, y, xv, n) fov_blit_row(addr, y, xv, n)
+#else
+#define blit_map_line(addr, y, xv, n) blit_map_row(addr, map_row_span(y, xv, n), xv, n)
+#endif
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/** 
+ * display_window(): affichage du contour de la fenêtre d'affichage de la carte
+ */
+void display_window() {
+    uchar y, x;
+    char *addr = (char *) (TEXT_SCREEN + WY*SCREEN_WIDTH + WX);
+
+    #define WIN_EXT_WIDTH   (WIN_XSIZE + 2)  // largeur totale de la fenêtre avec son cadre
+    #define WIN_EXT_HEIGHT  (WIN_YSIZE + 2)  // hauteur totale de la fenêtre avec son cadre
+
+    // trait haut
+    for(x=0; x < WIN_EXT_WIDTH; x++) {
+        *addr++ = C_CHECKERBOARD; // caractère damier
+    }
+    addr += (SCREEN_WIDTH - WIN_EXT_WIDTH);
+    // traits verticaux gauche et droit
+    for(y=1; y < WIN_EXT_HEIGHT-1; y++) {
+        *addr = C_CHECKERBOARD; // caractère damier
+        addr += WIN_EXT_WIDTH-1;
+        *addr = C_CHECKERBOARD; // caractère damier
+        addr += (SCREEN_WIDTH - WIN_EXT_WIDTH + 1);
+    }
+    // trait bas
+    for(x=0; x < WIN_EXT_WIDTH; x++) {
+        *addr++ = C_CHECKERBOARD; // caractère damier
+    }
+    count_writes(2*WIN_EXT_WIDTH + 2*(WIN_EXT_HEIGHT-2));
+#ifdef VIEW_SPLIT
+    // séparation des 2 fenêtres
+    addr = (char *) (TEXT_SCREEN + (WY+1)*SCREEN_WIDTH + WX+1 + VIEW_SPLIT_LEFT);
+    for(y=0; y < WIN_YSIZE; y++) {
+        *addr = C_CHECKERBOARD;
+        addr += SCREEN_WIDTH;
+    }
+    count_writes(WIN_YSIZE);
+#endif
+    // Affichage des instructions sous la fenêtre:
+    gotoxy(WX+4, WY+WIN_EXT_HEIGHT);   printf("Deplacements: fleches");
+    gotoxy(WX+4, WY+WIN_EXT_HEIGHT+1); printf("    ESC = quitter");
+}
+
+/** 
+ * blit_map_row(addr, cell_addr, xv, n): affichage à l'adresse écran addr des n cases de la carte
+ * à partir de l'octet cell_addr (qui contient la case n° xv)
+ * 
+ * v1.5: décodage par paires: chaque octet de la carte donne directement ses 2 caractères via les
+ * tables cell_char_even[] / cell_char_odd[] (voir init_cell_chars()), sans test de parité par case.
+ * Si xv est impair, la 1ère case (quartet inférieur du 1er octet) est traitée à part, de même que
+ * la dernière case si le nombre de cases restantes est impair.
+ */
+void blit_map_row(char *addr, char *cell_addr, coord xv, uchar n) {
+    uchar j, c;
+
+    count_writes(n);
+#if defined(BLIT_ASM)
+    // version assembleur (blit.s), écrite pour la largeur de la fenêtre principale
+#if WIN_XSIZE != 30 || MAP_XSIZE != 100
+#error "blit.s: constantes WIN_XSIZE / MAP_ROW_BYTES à mettre à jour"
+#endif
+    if(n == WIN_XSIZE) {
+        asm_blit_row(addr, cell_addr, xv);
+        return;
+    }
+#elif defined(BLIT_GEN)
+    // routines déroulées générées pour la largeur de la fenêtre principale (blit_gen.c)
+    if(n == WIN_XSIZE) {
+        if(is_odd(xv)) blit_row_odd(addr, cell_addr);
+        else           blit_row_even(addr, cell_addr);
+        return;
+    }
+#endif
+    if(is_odd(xv)) {
+        *addr++ = cell_char_odd[(uchar) *cell_addr++];
+        n--;
+    }
+    for(j = div2(n); j > 0; j--) {
+        c = (uchar) *cell_addr++;
+        *addr++ = cell_char_even[c];
+        *addr++ = cell_char_odd[c];
+    }
+    if(is_odd(n)) *addr = cell_char_even[(uchar) *cell_addr];
+}
+
+/** 
+ * viewport_init(vp, addr, xsize, ysize, follow): fenêtre de xsize x ysize cases à l'adresse addr
+ * (écran ou tampon), qui suit le personnage follow; elle sera entièrement affichée à la 1ère passe
+ */
+void viewport_init(viewport *vp, char *addr, uchar xsize, uchar ysize, position *follow) {
+    vp->addr   = addr;
+    vp->xsize  = xsize;
+    vp->ysize  = ysize;
+    vp->follow = follow;
+    vp->xv = vp->yv = 0;
+    vp->dirty  = TRUE;
+    vp->exposed = VIEW_EXPOSED_NONE;
+}
+
+/** 
+ * draw_map_full(vp): affichage complet de la partie visible de la carte dans la fenêtre vp,
+ * (vp->xv, vp->yv) étant les coordonnées du coin supérieur gauche de cette partie visible
+ */
+void draw_map_full(viewport *vp) {
+    uchar i;
+#if defined(MAP_DENSE) && defined(BLIT_GEN) && !defined(FOG)
+    char *cell_addr;
+#endif
+
+#ifdef MAP_LAZY
+    map_prepare(vp->yv, vp->xv, vp->ysize, vp->xsize);
+#endif
+#if defined(MAP_DENSE) && defined(BLIT_GEN) && !defined(FOG)
+    if(vp->addr == WIN_ADDR && vp->xsize == WIN_XSIZE && vp->ysize == WIN_YSIZE) {
+        // fenêtre principale: d'un seul appel, adresses écran constantes (blit_gen.c)
+        cell_addr = &map[vp->yv][div2(vp->xv)];
+        if(is_odd(vp->xv)) blit_window_odd(cell_addr);
+        else               blit_window_even(cell_addr);
+        count_writes(WIN_XSIZE*WIN_YSIZE);
+        return;
+    }
+#endif
+    for(i=0; i < vp->ysize; i++) {
+        draw_map_row(vp, i);
+    }
+}
+
+/** 
+ * draw_map_row(vp, row): affichage d'une seule ligne de la carte (ligne vp->yv + row, à partir de
+ * la colonne vp->xv) sur la ligne n° row (relative) de la fenêtre vp.
+ * La partie de cette ligne déjà affichée par une fenêtre précédente de la passe en cours est
+ * recopiée depuis cette fenêtre: seul le reste est décodé
+ */
+void draw_map_row(viewport *vp, uchar row) {
+    coord y = vp->yv + row, xv = vp->xv, x0, x1;
+    uchar n = vp->xsize, k, j;
+    char *addr = vp->addr + row*SCREEN_WIDTH;
+    char *src;
+    viewport *other = shared_views;
+
+    for(k = 0; k < nb_shared_views; k++, other++) {
+        if(y < other->yv || y >= other->yv + other->ysize) continue;
+        // partie commune [x0, x1[ des 2 lignes
+        x0 = (xv > other->xv) ? xv : other->xv;
+        x1 = (xv + n < other->xv + other->xsize) ? xv + n : other->xv + other->xsize;
+        if(x0 >= x1) continue;
+
+        if(x0 > xv) {
+#ifdef MAP_LAZY
+            map_prepare(y, xv, 1, (uchar) (x0 - xv));
+#endif
+            blit_map_line(addr, y, xv, (uchar) (x0 - xv));
+        }
+        src = other->addr + (y - other->yv)*SCREEN_WIDTH + (x0 - other->xv);
+        addr += x0 - xv;
+        for(j = (uchar) (x1 - x0); j > 0; j--) {
+            *addr++ = *src++;
+        }
+        count_writes(x1 - x0);
+        if(x1 < xv + n) {
+#ifdef MAP_LAZY
+            map_prepare(y, x1, 1, (uchar) (xv + n - x1));
+#endif
+            blit_map_line(addr, y, x1, (uchar) (xv + n - x1));
+        }
+        return;
+    }
+
+#ifdef MAP_LAZY
+    map_prepare(y, xv, 1, n);
+#endif
+    blit_map_line(addr, y, xv, n);
+}
+
+/** 
+ * draw_map_column(vp, col): affichage d'une seule colonne de la carte (colonne vp->xv + col, à
+ * partir de la ligne vp->yv) sur la colonne n° col (relative) de la fenêtre vp
+ */
+void draw_map_column(viewport *vp, uchar col) {
+    coord x = vp->xv + col, yv = vp->yv;
+    uchar i, n = vp->ysize;
+    char *addr = vp->addr + col;
+#ifdef MAP_DENSE
+    char *current_cell_addr = &map[yv][div2(x)];
+    // la parité de x est la même pour toute la colonne: on ne choisit la table qu'une seule fois
+    char *cell_chars = is_odd(x) ? cell_char_odd : cell_char_even;
+#endif
+#ifdef FOG
+    // de même pour le bit de la colonne dans le plan exploré
+    uchar *seen = &fov_explored[yv][x >> 3];
+    uchar mask = walk_bit[x & 7];
+#endif
+
+#ifdef MAP_LAZY
+    map_prepare(yv, x, n, 1);
+#endif
+    count_writes(n);
+#ifndef MAP_DENSE
+    for(i=0; i < n; i++) {
+        *addr = get_map_cell_char(yv+i, x);
+        addr += SCREEN_WIDTH;
+    }
+#else
+    for(i=0; i < n; i++) {
+#ifdef FOG
+        *addr = (*seen & mask) ? cell_chars[(uchar) *current_cell_addr] : C_FOG;
+        seen += WALK_PLANE_BYTES;
+#else
+        *addr = cell_chars[(uchar) *current_cell_addr];
+#endif
+        addr += SCREEN_WIDTH;
+        current_cell_addr += MAP_XSIZE/2;
+    }
+#endif
+}
+
+/** 
+ * scroll_view_down(vp): la partie visible descend d'une ligne (yv+1) => décalage du contenu
+ * de la fenêtre d'une ligne vers le HAUT, directement dans la mémoire écran (ou le tampon).
+ * La dernière ligne de la fenêtre reste à redessiner (draw_map_row())
+ */
+void scroll_view_down(viewport *vp) {
+    uchar i, j, n = vp->xsize;
+    char *dst = vp->addr;
+    char *src = dst + SCREEN_WIDTH;
+
+    count_writes((vp->ysize-1)*n);
+    for(i=1; i < vp->ysize; i++) {
+        for(j=0; j < n; j++) {
+            *dst++ = *src++;
+        }
+        dst += (SCREEN_WIDTH - n);
+        src += (SCREEN_WIDTH - n);
+    }
+}
+
+/** 
+ * scroll_view_up(vp): la partie visible monte d'une ligne (yv-1) => décalage du contenu
+ * de la fenêtre d'une ligne vers le BAS (en partant du bas pour ne rien écraser).
+ * La première ligne de la fenêtre reste à redessiner (draw_map_row())
+ */
+void scroll_view_up(viewport *vp) {
+    uchar i, j, n = vp->xsize;
+    char *dst = vp->addr + (vp->ysize-1)*SCREEN_WIDTH;
+    char *src = dst - SCREEN_WIDTH;
+
+    count_writes((vp->ysize-1)*n);
+    for(i=1; i < vp->ysize; i++) {
+        for(j=0; j < n; j++) {
+            *dst++ = *src++;
+        }
+        dst -= (SCREEN_WIDTH + n);
+        src -= (SCREEN_WIDTH + n);
+    }
+}
+
+/** 
+ * scroll_view_right(vp): la partie visible se décale d'une colonne à droite (xv+1) => décalage du
+ * contenu de la fenêtre d'une colonne vers la GAUCHE.
+ * La dernière colonne de la fenêtre reste à redessiner (draw_map_column())
+ */
+void scroll_view_right(viewport *vp) {
+    uchar i, j, n = vp->xsize;
+    char *addr = vp->addr;
+
+    count_writes(vp->ysize*(n-1));
+    for(i=0; i < vp->ysize; i++) {
+        for(j=1; j < n; j++) {
+            *addr = *(addr+1);
+            addr++;
+        }
+        addr += (SCREEN_WIDTH - n + 1);
+    }
+}
+
+/** 
+ * scroll_view_left(vp): la partie visible se décale d'une colonne à gauche (xv-1) => décalage du
+ * contenu de la fenêtre d'une colonne vers la DROITE (en partant de la droite de chaque ligne).
+ * La première colonne de la fenêtre reste à redessiner (draw_map_column())
+ */
+void scroll_view_left(viewport *vp) {
+    uchar i, j, n = vp->xsize;
+    char *addr = vp->addr + (n-1);
+
+    count_writes(vp->ysize*(n-1));
+    for(i=0; i < vp->ysize; i++) {
+        for(j=1; j < n; j++) {
+            *addr = *(addr-1);
+            addr--;
+        }
+        addr += (SCREEN_WIDTH + n - 1);
+    }
+}
+
+/** 
+ * view_origin(p, size, map_size): 1ère case visible (xv ou yv) d'une fenêtre de size cases
+ * centrée sur la case p, sauf aux extrémités de la carte
+ */
+static coord view_origin(coord p, uchar size, coord map_size) {
+    coord v;
+
+    if(p <= size/2) v = 0; else v = p - size/2;
+    //  Corrections pour affichage extrémités droite et inferieure de la carte
+    if(p >= map_size - size/2) v = map_size - size;
+    return v;
+}
+
+/** 
+ * viewport_update(vp): mise à jour de la partie visible de la carte dans la fenêtre vp, qui suit
+ * son personnage. Affichage incrémental (v1.3): les personnages et les entités déplacées affichés
+ * à la passe précédente sont effacés (= case de la carte réaffichée), puis
+ * - si la partie visible ne bouge pas, rien d'autre à faire
+ * - si la partie visible se décale d'une case, le contenu de la fenêtre est décalé directement
+ *   dans la mémoire écran, et seule la ligne ou la colonne nouvellement visible est décodée
+ * - sinon (1ère passe ou "saut" de la partie visible), affichage complet
+ * La partie décodée est notée dans vp->exposed (pour l'affichage des entités)
+ */
+static void viewport_update(viewport *vp) {
+    coord xv = view_origin(vp->follow->x, vp->xsize, MAP_XSIZE);
+    coord yv = view_origin(vp->follow->y, vp->ysize, MAP_YSIZE);
+    position *p = old_players;
+    uchar k;
+
+    stats_mark(STAGE_VIEW);
+    if(vp->dirty) {
+        vp->xv = xv; vp->yv = yv;
+        vp->dirty = FALSE;
+        vp->exposed = VIEW_EXPOSED_FULL;
+        draw_map_full(vp);
+        return;
+    }
+
+    // effacer les personnages à leur ancienne position (= réafficher la case de la carte, ou
+    // l'entité qui s'y trouve)
+    for(k = 0; k < old_nb_players; k++, p++) {
+        if(p->x >= vp->xv && p->x < vp->xv + vp->xsize && p->y >= vp->yv && p->y < vp->yv + vp->ysize) {
+            vp->addr[(p->y - vp->yv)*SCREEN_WIDTH + (p->x - vp->xv)] = cell_char_under(p->y, p->x);
+            count_writes(1);
+        }
+    }
+#ifdef ENTITIES
+    entities_erase_moved(vp);
+#endif
+    stats_mark(STAGE_PLAYER);
+
+    // puis ne redessiner que ce qui a changé
+    if(xv == vp->xv && yv == vp->yv) {
+        // partie visible inchangée: rien d'autre à faire
+        vp->exposed = VIEW_EXPOSED_NONE;
+    }
+    else if(xv == vp->xv && yv == vp->yv+1) {
+        vp->yv = yv;
+        scroll_view_down(vp);
+        vp->exposed = VIEW_EXPOSED_ROW;
+        vp->exposed_at = vp->ysize-1;
+        draw_map_row(vp, vp->ysize-1);
+    }
+    else if(xv == vp->xv && yv+1 == vp->yv) {
+        vp->yv = yv;
+        scroll_view_up(vp);
+        vp->exposed = VIEW_EXPOSED_ROW;
+        vp->exposed_at = 0;
+        draw_map_row(vp, 0);
+    }
+    else if(yv == vp->yv && xv == vp->xv+1) {
+        vp->xv = xv;
+        scroll_view_right(vp);
+        vp->exposed = VIEW_EXPOSED_COLUMN;
+        vp->exposed_at = vp->xsize-1;
+        draw_map_column(vp, vp->xsize-1);
+    }
+    else if(yv == vp->yv && xv+1 == vp->xv) {
+        vp->xv = xv;
+        scroll_view_left(vp);
+        vp->exposed = VIEW_EXPOSED_COLUMN;
+        vp->exposed_at = 0;
+        draw_map_column(vp, 0);
+    }
+    else {
+        // "saut" de la partie visible: affichage complet
+        vp->xv = xv; vp->yv = yv;
+        vp->exposed = VIEW_EXPOSED_FULL;
+        draw_map_full(vp);
+    }
+}
+
+/** 
+ * render_viewports(views, nb_views, players, nb_players): passe d'affichage d'une frame dans
+ * les nb_views fenêtres views[] (chacune mise à jour de façon incrémentale), puis affichage des
+ * nb_players personnages players[] (au plus NB_PLAYERS_MAX) dans toutes les fenêtres où ils sont
+ * visibles; avec ENTITIES, les entités sont affichées avant les personnages (voir entity.c).
+ * Le travail est partagé: une ligne de la carte déjà présente dans une fenêtre mise à jour plus
+ * tôt dans la passe est recopiée, pas décodée à nouveau (le coût d'une passe dépend donc du
+ * nombre de cases modifiées, pas du nombre de fenêtres)
+ */
+void render_viewports(viewport *views, uchar nb_views, position *players, uchar nb_players) {
+    uchar v, k;
+    viewport *vp = views;
+    position *p;
+
+    shared_views = views;
+    for(v = 0; v < nb_views; v++, vp++) {
+        nb_shared_views = v;
+        viewport_update(vp);
+#ifdef FOG
+        // cases découvertes et entités entrées / sorties du champ de vision
+        fov_redraw(vp);
+#endif
+        stats_mark(STAGE_BLIT);
+        input_sample();
+    }
+    nb_shared_views = 0;
+
+    // entités (dans la partie décodée et aux cases modifiées), puis personnages, par-dessus
+    // la carte de toutes les fenêtres
+    for(v = 0, vp = views; v < nb_views; v++, vp++) {
+#ifdef ENTITIES
+        entities_overlay(vp);
+#endif
+        for(k = 0, p = players; k < nb_players; k++, p++) {
+            if(p->x >= vp->xv && p->x < vp->xv + vp->xsize && p->y >= vp->yv && p->y < vp->yv + vp->ysize) {
+                vp->addr[(p->y - vp->yv)*SCREEN_WIDTH + (p->x - vp->xv)] = C_PLAYER;
+                count_writes(1);
+            }
+        }
+    }
+
+    // mémoriser les positions affichées pour les effacer à la passe suivante
+    for(k = 0, p = players; k < nb_players; k++, p++) {
+        old_players[k] = *p;
+    }
+    old_nb_players = nb_players;
+#ifdef ENTITIES
+    entities_moved_clear();
+#endif
+#ifdef FOG
+    fov_changes_clear();
+#endif
+}
+
+#ifdef DOUBLE_BUFFER
+/** 
+ * present_init(): initialisation du tampon de composition avec le contenu actuel de l'écran
+ * (lignes PRESENT_FIRST_ROW à PRESENT_LAST_ROW: infos, cadre et partie visible de la carte)
+ */
+void present_init() {
+    int i;
+    char *src = (char *) (TEXT_SCREEN + PRESENT_FIRST_ROW*SCREEN_WIDTH);
+    char *dst = back_buffer;
+
+    for(i=0; i < PRESENT_ROWS*SCREEN_WIDTH; i++) {
+        *dst++ = *src++;
+    }
+    count_writes(PRESENT_ROWS*SCREEN_WIDTH);
+}
+
+/** 
+ * present_frame(): présentation de la frame composée dans le tampon: attente du "tic" d'affichage
+ * puis recopie du tampon dans l'écran, en une seule boucle sur des adresses contiguës
+ * NB: l'écran TEXT de l'Oric est unique (pas de 2e zone de caractères à "basculer"), d'où la recopie
+ */
+void present_frame() {
+    int i;
+    char *src = back_buffer;
+    char *dst = (char *) (TEXT_SCREEN + PRESENT_FIRST_ROW*SCREEN_WIDTH);
+
+    wait_vsync();
+    for(i=0; i < PRESENT_ROWS*SCREEN_WIDTH; i++) {
+        *dst++ = *src++;
+    }
+    count_writes(PRESENT_ROWS*SCREEN_WIDTH);
+}
+#endif
@@ -0,0 +1,98 @@
+/**
+ *      CTextMovingMap - rle.c
+ *      ======================
+ * 
+ *      Mode MAP_RLE: carte compressée ligne par ligne, en suites ("runs") de cellules identiques.
+ *      La carte n'est jamais décompressée: l'affichage et les tests de collision lisent directement
+ *      la forme compressée.
+ * 
+ *      Format (généré par host/mkworld -f rle):
+ *      - map_rle_rows[y]: position dans map_rle_data[] du début de la ligne y (accès direct à une
+ *        ligne), map_rle_rows[MAP_YSIZE] = taille totale des données
+ *      - map_rle_data[]: pour chaque run, 1 octet: quartet supérieur = valeur V_xxx,
+ *        quartet inférieur = n: longueur n+1 si n < 15, sinon longueur 16 + octet suivant
+ */
+
+#include "movingmap.h"
+
+#ifdef MAP_RLE
+
+
+/* ================== CONSTANTES ================== */
+
+#define RLE_LONG_RUN 15 // quartet de longueur indiquant un octet de longueur supplémentaire
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// run trouvé par rle_seek(): valeur, et nombre de cellules du run à partir de la cellule cherchée
+static uchar        run_value;
+static unsigned int run_left;
+static uchar       *run_next; // octet suivant le run dans map_rle_data[]
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/** 
+ * rle_seek(y, x): recherche, dans la ligne y, du run contenant la cellule x
+ * (résultat dans run_value, run_left et run_next)
+ */
+static void rle_seek(coord y, coord x) {
+    uchar *data = map_rle_data + map_rle_rows[y];
+    unsigned int pos = 0, len;
+    uchar b;
+
+    for(;;) {
+        b = *data++;
+        len = get_low_quartet(b);
+        if(len == RLE_LONG_RUN) len = 16 + *data++; else len++;
+        if(x < pos + len) break;
+        pos += len;
+    }
+    run_value = get_high_quartet(b);
+    run_left  = pos + len - x;
+    run_next  = data;
+}
+
+/** 
+ * map_cell_value(y, x): valeur V_xxx de la cellule (y, x) de la carte
+ */
+uchar map_cell_value(coord y, coord x) {
+    rle_seek(y, x);
+    return run_value;
+}
+
+/** 
+ * rle_blit_row(addr, y, x, count): affichage à l'adresse addr des count cellules de la ligne y
+ * à partir de la cellule x, run par run (un seul caractère à déterminer par run)
+ */
+void rle_blit_row(char *addr, coord y, coord x, uchar count) {
+    uchar left = count;
+    uchar n, b;
+    unsigned int len;
+    uchar *data;
+    char c;
+
+    count_writes(count);
+    rle_seek(y, x);
+    data = run_next;
+    c = get_cvalue(run_value);
+    n = (run_left < left) ? (uchar) run_left : left;
+
+    for(;;) {
+        left -= n;
+        for(; n > 0; n--) {
+            *addr++ = c;
+        }
+        if(left == 0) break;
+
+        // run suivant
+        b = *data++;
+        c = get_cvalue(get_high_quartet(b));
+        len = get_low_quartet(b);
+        if(len == RLE_LONG_RUN) len = 16 + *data++; else len++;
+        n = (len < left) ? (uchar) len : left;
+    }
+}
+
+#endif /* MAP_RLE */
@@ -0,0 +1,196 @@
+/**
+ *      CTextMovingMap - stats.c
+ *      ========================
+ *
+ *      Mesure des étapes d'une frame (option FRAME_STATS): play_map() et render_viewports() appellent
+ *      stats_mark(STAGE_xxx) à la fin de chaque étape: le temps écoulé depuis l'appel précédent est
+ *      ajouté à cette étape (une étape peut donc être mesurée en plusieurs morceaux, ex. une fois par
+ *      fenêtre). stats_frame() termine la frame: la durée de chaque étape est gardée pour les
+ *      STATS_FRAMES dernières frames, et toutes les STATS_FRAMES frames, le min / la moyenne / le max
+ *      d'une étape (la suivante à chaque fois) sont affichés sur la ligne STATS_ROW:
+ *
+ *          CARTE MIN=ddddd MOY=ddddd MAX=ddddd
+ *
+ *      Le temps est lu sur le timer 2 du VIA (Oric) ou l'horloge monotone (PC), en µs; le temps de
+ *      stats_frame() lui-même n'est compté dans aucune étape.
+ */
+
+#include "movingmap.h"
+
+#ifdef FRAME_STATS
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// durée cumulée de chaque étape
+unsigned long stats_total[STAGE_COUNT];
+
+// durées de chaque étape aux STATS_FRAMES dernières frames (tableau circulaire, frame n° stats_pos),
+// durée de chaque étape dans la frame en cours
+static unsigned int stats_samples[STAGE_COUNT][STATS_FRAMES];
+static unsigned int stats_acc[STAGE_COUNT];
+static uchar stats_pos;
+
+// étape affichée à la prochaine fin de série de STATS_FRAMES frames
+static uchar stats_shown;
+
+// timer et compteur système à la fin de l'étape précédente
+static unsigned int stats_t0;
+static uchar stats_tick0;
+
+static char *stats_labels[STAGE_COUNT] = { "CLAV ", "VUES ", "CARTE", "PERSO", "INFOS" };
+static unsigned int stats_pow10[] = { 10000, 1000, 100, 10 };
+
+
+/* ================== MACROS ================== */
+
+#define STATS_ADDR ((char *) (TEXT_SCREEN + STATS_ROW*SCREEN_WIDTH + 2))
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/**
+ * stats_clock(): valeur du timer (décroissant, 1 unité = 1 µs)
+ */
+static unsigned int stats_clock() {
+#ifdef HOST_BUILD
+    return host_timer_read();
+#else
+    // octet fort relu: si l'octet faible est passé de 0 à 0xFF entre les 2 lectures, on relit
+    uchar hi = VIA_T2_HI;
+    uchar lo = VIA_T2_LO;
+
+    if(VIA_T2_HI != hi) {
+        hi = VIA_T2_HI;
+        lo = VIA_T2_LO;
+    }
+    return ((unsigned int) hi << 8) | lo;
+#endif
+}
+
+/**
+ * stats_restart(): début de l'étape suivante
+ */
+static void stats_restart() {
+    stats_t0 = stats_clock();
+    stats_tick0 = SYS_TIMER_LO;
+}
+
+/**
+ * stats_init(): lancement du timer, aucune durée mesurée
+ */
+void stats_init() {
+    uchar s, k;
+
+    timer_start();
+    for(s = 0; s < STAGE_COUNT; s++) {
+        stats_total[s] = 0;
+        stats_acc[s] = 0;
+        for(k = 0; k < STATS_FRAMES; k++) {
+            stats_samples[s][k] = 0;
+        }
+    }
+    stats_pos = 0;
+    stats_shown = 0;
+    stats_restart();
+}
+
+/**
+ * stats_mark(stage): fin d'un morceau de l'étape stage, le suivant commence
+ */
+void stats_mark(uchar stage) {
+    unsigned int now = stats_clock();
+    unsigned int elapsed = stats_t0 - now;
+#ifndef HOST_BUILD
+    // le timer 16 bits fait le tour en 65,5 ms: le compteur système (10 ms par tic, +/- 1 tic) le
+    // détecte, la durée est alors saturée
+    uchar tick = SYS_TIMER_LO;
+    uchar ticks = stats_tick0 - tick;
+
+    if(ticks >= 8 || (ticks >= 6 && elapsed < 0x8000)) elapsed = STATS_MAX;
+    stats_tick0 = tick;
+#else
+    if(elapsed > STATS_MAX) elapsed = STATS_MAX;
+#endif
+
+    stats_t0 = now;
+    stats_total[stage] += elapsed;
+    // cumul saturé
+    if(stats_acc[stage] > STATS_MAX - elapsed) stats_acc[stage] = STATS_MAX;
+    else                                       stats_acc[stage] += elapsed;
+}
+
+/**
+ * stats_draw_value(addr, value): affichage de value sur 5 chiffres, cadrée à droite
+ */
+static void stats_draw_value(char *addr, unsigned int value) {
+    uchar k;
+    char digit;
+
+    for(k = 0; k < sizeof(stats_pow10)/sizeof(stats_pow10[0]); k++) {
+        for(digit = '0'; value >= stats_pow10[k]; digit++) {
+            value -= stats_pow10[k];
+        }
+        *addr++ = digit;
+    }
+    *addr = '0' + value;
+    // zéros non significatifs remplacés par des espaces
+    for(addr -= 4, k = 0; k < 4 && *addr == '0'; k++) {
+        *addr++ = ' ';
+    }
+    count_writes(5 + k);
+}
+
+/**
+ * stats_draw(stage): affichage du min / de la moyenne / du max des STATS_FRAMES dernières durées
+ * de l'étape stage
+ */
+static void stats_draw(uchar stage) {
+    unsigned int *sample = stats_samples[stage];
+    unsigned int vmin = STATS_MAX, vmax = 0;
+    unsigned long sum = 0;
+    char *addr = STATS_ADDR;
+    char *text;
+    uchar k;
+
+    for(k = 0; k < STATS_FRAMES; k++, sample++) {
+        if(*sample < vmin) vmin = *sample;
+        if(*sample > vmax) vmax = *sample;
+        sum += *sample;
+    }
+
+    for(text = stats_labels[stage]; *text != '\0'; text++) {
+        *addr++ = *text;
+    }
+    count_writes(text - stats_labels[stage] + 3*5);     // + " MIN=", " MOY=", " MAX="
+    for(text = " MIN="; *text != '\0'; text++) *addr++ = *text;
+    stats_draw_value(addr, vmin);
+    addr += 5;
+    for(text = " MOY="; *text != '\0'; text++) *addr++ = *text;
+    stats_draw_value(addr, (unsigned int) (sum >> STATS_SHIFT));
+    addr += 5;
+    for(text = " MAX="; *text != '\0'; text++) *addr++ = *text;
+    stats_draw_value(addr, vmax);
+}
+
+/**
+ * stats_frame(): fin de la frame, durées de ses étapes gardées; affichage d'une étape toutes
+ * les STATS_FRAMES frames
+ */
+void stats_frame() {
+    uchar s;
+
+    for(s = 0; s < STAGE_COUNT; s++) {
+        stats_samples[s][stats_pos] = stats_acc[s];
+        stats_acc[s] = 0;
+    }
+    stats_pos = (stats_pos + 1) & (STATS_FRAMES-1);
+    if(stats_pos == 0) {
+        stats_draw(stats_shown);
+        if(++stats_shown == STAGE_COUNT) stats_shown = 0;
+    }
+    // le temps d'affichage n'est compté dans aucune étape
+    stats_restart();
+}
+
+#endif /* FRAME_STATS */
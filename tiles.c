@@ -0,0 +1,186 @@
+/**
+ *      CTextMovingMap - tiles.c
+ *      ========================
+ * 
+ *      Mode MAP_TILED: monde plus grand que la RAM, découpé en tuiles de TILE_SIZE x TILE_SIZE
+ *      cellules (2 cellules par octet, comme map[][]), lues à la demande sur un support externe.
+ * 
+ *      Format du monde sur le support (voir host/mkworld.c qui le génère):
+ *      - en-tête de WORLD_HEADER_SIZE octets: "MMW1", largeur et hauteur (16 bits, poids faible
+ *        en premier), taille des tuiles
+ *      - répertoire des tuiles: pour chaque tuile (ligne par ligne), n° de bloc sur 16 bits
+ *        (plusieurs tuiles identiques, typiquement vides, peuvent partager le même bloc)
+ *      - blocs de TILE_BYTES octets
+ * 
+ *      Seules TILE_CACHE_SLOTS tuiles sont gardées en RAM: en cas de défaut, la tuile utilisée
+ *      le moins récemment (LRU) est remplacée.
+ */
+
+#include "movingmap.h"
+
+#ifdef MAP_TILED
+
+#ifndef HOST_BUILD
+#error "MAP_TILED: pas encore de support de stockage externe (disquette/cassette) sur Oric"
+#endif
+
+
+/* ================== CONSTANTES ================== */
+
+#define TILE_ROW_BYTES (TILE_SIZE/2)               // octets par ligne de tuile
+#define TILE_BYTES     (TILE_ROW_BYTES*TILE_SIZE)  // octets par tuile
+#define TILES_X        (MAP_XSIZE/TILE_SIZE)       // nombre de tuiles en X
+#define TILES_Y        (MAP_YSIZE/TILE_SIZE)       // nombre de tuiles en Y
+
+#define WORLD_HEADER_SIZE 16
+#define WORLD_DIR_OFFSET  WORLD_HEADER_SIZE
+#define WORLD_DATA_OFFSET (WORLD_DIR_OFFSET + 2UL*TILES_X*TILES_Y)
+
+#define NO_TILE 0xFFFF
+
+// n° de la tuile contenant la cellule (y, x)
+#define tile_id(y, x) (((y) >> TILE_SHIFT) * TILES_X + ((x) >> TILE_SHIFT))
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+// cache de tuiles: contenu, n° de tuile et "date" de dernière utilisation de chaque emplacement
+static char         tile_data[TILE_CACHE_SLOTS][TILE_BYTES];
+static unsigned int tile_ids[TILE_CACHE_SLOTS];
+static unsigned int tile_stamps[TILE_CACHE_SLOTS];
+static unsigned int tile_clock;
+
+// dernière tuile utilisée (les accès successifs portent presque toujours sur la même tuile)
+static unsigned int last_tile_id;
+static char        *last_tile;
+
+// monde valide sur le support externe ? (sinon toutes les tuiles sont vides)
+static bool world_ok;
+
+// ligne de cellules reconstituée pour l'affichage (les octets d'une ligne de la fenêtre
+// peuvent provenir de plusieurs tuiles)
+static char row_span[VIEW_MAX_XSIZE/2 + 1];
+
+unsigned long tile_misses;
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/** 
+ * tile_cache_init(): ouverture du support externe, vérification de l'en-tête et vidage du cache
+ */
+void tile_cache_init() {
+    char header[WORLD_HEADER_SIZE];
+    uchar i;
+
+    for(i=0; i < TILE_CACHE_SLOTS; i++) {
+        tile_ids[i] = NO_TILE;
+        tile_stamps[i] = 0;
+    }
+    tile_clock = 0;
+    last_tile_id = NO_TILE;
+    tile_misses = 0;
+
+    world_ok = store_open(STORE_DATA);
+    if(world_ok) {
+        world_ok = store_read(0, header, WORLD_HEADER_SIZE)
+                && header[0] == 'M' && header[1] == 'M' && header[2] == 'W' && header[3] == '1'
+                && ((uchar) header[4] | ((uchar) header[5] << 8)) == MAP_XSIZE
+                && ((uchar) header[6] | ((uchar) header[7] << 8)) == MAP_YSIZE
+                && header[8] == TILE_SIZE;
+    }
+    if(!world_ok) printf("Monde absent ou incompatible!\n");
+}
+
+/** 
+ * tile_load(id, addr): lecture de la tuile n° id sur le support externe (répertoire puis bloc);
+ * tuile vide si le monde est absent ou tronqué
+ */
+static void tile_load(unsigned int id, char *addr) {
+    char entry[2];
+    unsigned int block;
+    unsigned int i;
+
+    if(world_ok && store_read(WORLD_DIR_OFFSET + 2UL*id, entry, 2)) {
+        block = (uchar) entry[0] | ((uchar) entry[1] << 8);
+        if(store_read(WORLD_DATA_OFFSET + (unsigned long) block*TILE_BYTES, addr, TILE_BYTES)) return;
+    }
+    for(i=0; i < TILE_BYTES; i++) addr[i] = combine_cellvalues(V_EMPTY, V_EMPTY);
+}
+
+/** 
+ * get_tile(id): adresse en RAM de la tuile n° id, lue sur le support si elle n'est pas en cache
+ * (en remplaçant la tuile la moins récemment utilisée)
+ */
+static char *get_tile(unsigned int id) {
+    uchar i, slot;
+    bool found = FALSE;
+
+    if(id == last_tile_id) return last_tile;
+
+    if(++tile_clock == 0) {
+        // l'horloge a fait le tour: on repart de 0 (l'ordre LRU est perdu une fois, sans gravité)
+        for(i=0; i < TILE_CACHE_SLOTS; i++) tile_stamps[i] = 0;
+        tile_clock = 1;
+    }
+
+    for(slot=0; slot < TILE_CACHE_SLOTS; slot++) {
+        if(tile_ids[slot] == id) {
+            found = TRUE;
+            break;
+        }
+    }
+    if(!found) {
+        // défaut de cache: emplacement le moins récemment utilisé
+        slot = 0;
+        for(i=1; i < TILE_CACHE_SLOTS; i++) {
+            if(tile_stamps[i] < tile_stamps[slot]) slot = i;
+        }
+        tile_load(id, tile_data[slot]);
+        tile_ids[slot] = id;
+        tile_misses++;
+    }
+    tile_stamps[slot] = tile_clock;
+    last_tile_id = id;
+    last_tile = tile_data[slot];
+    return last_tile;
+}
+
+/** 
+ * map_cell_value(y, x): valeur V_xxx de la cellule (y, x) du monde
+ */
+uchar map_cell_value(coord y, coord x) {
+    char *tile = get_tile(tile_id(y, x));
+    char val = tile[(y & (TILE_SIZE-1))*TILE_ROW_BYTES + div2(x & (TILE_SIZE-1))];
+
+    return get_cellvalue(x, val);
+}
+
+/** 
+ * map_row_span(y, x, width): reconstitue dans row_span[] les octets de la ligne y du monde nécessaires
+ * à l'affichage de width cellules à partir de la cellule x, et renvoie son adresse
+ * (même convention que map_row_span() en mode map[][]: le 1er octet contient la cellule x)
+ */
+char *map_row_span(coord y, coord x, uchar width) {
+    coord bx = div2(x);                          // n° d'octet de la cellule x dans la ligne du monde
+    uchar count = div2(x + width - 1) - bx + 1;  // nombre d'octets à copier
+    uchar offset, n;
+    char *src, *dst = row_span;
+    unsigned int row_offset = (y & (TILE_SIZE-1))*TILE_ROW_BYTES;
+
+    while(count > 0) {
+        // octets de cette ligne restant dans la tuile courante
+        offset = bx & (TILE_ROW_BYTES-1);
+        n = TILE_ROW_BYTES - offset;
+        if(n > count) n = count;
+        src = get_tile(tile_id(y, mul2(bx))) + row_offset + offset;
+        count -= n;
+        bx += n;
+        for(; n > 0; n--) {
+            *dst++ = *src++;
+        }
+    }
+    return row_span;
+}
+
+#endif /* MAP_TILED */
@@ -0,0 +1,159 @@
+/**
+ *      CTextMovingMap - trace.c
+ *      ========================
+ *
+ *      Traces de parties (option INPUT_TRACE): la partie ne dépend que de la graine de la carte et
+ *      des événements clavier acceptés par play_map() (input_next() / input_wait()), frame par frame.
+ *      - enregistrement (TRACE_RECORD): chaque événement est noté dans trace_data[] avec l'écart en
+ *        frames depuis le précédent (0 = même frame, déplacements regroupés), sur un seul octet:
+ *            bits 3-7 = écart (0 à TRACE_DELTA_MAX), bits 0-2 = n° de la touche (trace_keys[])
+ *        un écart plus grand est complété par des octets "n° 0" (TRACE_DELTA_MAX frames sans
+ *        événement, ex. pendant un voyage PATHFIND)
+ *      - rejeu (TRACE_REPLAY): le clavier n'est plus lu, input_next() / input_wait() renvoient les
+ *        événements de la trace à leur frame
+ *      Dans les 2 cas, toutes les trace_every frames, une somme de contrôle de la fenêtre dans la
+ *      mémoire écran est enregistrée, ou comparée à celle de la trace (trace_errors).
+ */
+
+#include "movingmap.h"
+
+#ifdef INPUT_TRACE
+
+
+/* ================== CONSTANTES ================== */
+
+#define TRACE_DELTA_MAX 31
+
+
+/* ================== VARIABLES GLOBALES ================== */
+
+uchar        trace_mode = TRACE_OFF;
+unsigned int trace_seed;
+uchar        trace_every = TRACE_EVERY;
+uchar        trace_data[TRACE_MAX_EVENTS];
+unsigned int trace_length;
+unsigned int trace_sums[TRACE_MAX_SUMS];
+unsigned int trace_nb_sums;
+unsigned int trace_frames;
+unsigned int trace_errors, trace_error_frame;
+bool         trace_full;
+
+// prochain octet lu au rejeu, frame du dernier événement enregistré ou lu, somme de contrôle suivante
+static unsigned int trace_pos;
+static unsigned int trace_at;
+static unsigned int trace_sum_pos;
+
+// touches des événements, par n° (0 = pas d'événement)
+static uchar trace_keys[] = { NO_KEY, KEY_LEFT, KEY_RIGHT, KEY_UP, KEY_DOWN, KEY_SPACE, KEY_ESC };
+
+
+/* ================== MACROS ================== */
+
+#define WIN_SCREEN_ADDR ((char *) (TEXT_SCREEN + (WY+1)*SCREEN_WIDTH + WX+1))
+
+
+/* ================== IMPLEMENTATION DES FONCTIONS ================== */
+
+/**
+ * trace_start(mode): début d'un enregistrement (trace vidée; trace_seed et trace_every sont
+ * fixés par l'appelant) ou d'un rejeu de la trace (trace_data[], trace_length, trace_sums[],
+ * trace_nb_sums déjà remplis), avant play_map()
+ */
+void trace_start(uchar mode) {
+    trace_mode = mode;
+    if(mode == TRACE_RECORD) {
+        trace_length = 0;
+        trace_nb_sums = 0;
+    }
+    trace_pos = 0;
+    trace_at = 0;
+    trace_sum_pos = 0;
+    trace_frames = 0;
+    trace_errors = 0;
+    trace_error_frame = 0;
+    trace_full = FALSE;
+}
+
+/**
+ * window_checksum(): somme de contrôle (Fletcher 8 bits) des WIN_XSIZE x WIN_YSIZE caractères de la
+ * fenêtre dans la mémoire écran
+ */
+unsigned int window_checksum() {
+    char *addr = WIN_SCREEN_ADDR;
+    uchar i, j, sum1 = 0, sum2 = 0;
+
+    for(i = 0; i < WIN_YSIZE; i++) {
+        for(j = 0; j < WIN_XSIZE; j++) {
+            sum1 += (uchar) *addr++;
+            sum2 += sum1;
+        }
+        addr += SCREEN_WIDTH - WIN_XSIZE;
+    }
+    return ((unsigned int) sum2 << 8) | sum1;
+}
+
+/**
+ * trace_frame(): début de la gestion du clavier d'une nouvelle frame (frame affichée): somme de
+ * contrôle de la fenêtre toutes les trace_every frames
+ */
+void trace_frame() {
+    unsigned int sum;
+
+    if(trace_mode == TRACE_OFF) return;
+    if(trace_frames % trace_every == 0) {
+        sum = window_checksum();
+        if(trace_mode == TRACE_RECORD) {
+            if(trace_nb_sums < TRACE_MAX_SUMS) trace_sums[trace_nb_sums++] = sum;
+        }
+        else if(trace_sum_pos < trace_nb_sums) {
+            if(sum != trace_sums[trace_sum_pos] && trace_errors++ == 0) trace_error_frame = trace_frames;
+            trace_sum_pos++;
+        }
+    }
+    trace_frames++;
+}
+
+/**
+ * trace_store(code): ajout d'un octet à la trace (au-delà de TRACE_MAX_EVENTS, trace tronquée)
+ */
+static void trace_store(uchar code) {
+    if(trace_length < TRACE_MAX_EVENTS) trace_data[trace_length++] = code;
+    else trace_full = TRUE;
+}
+
+/**
+ * trace_put(key): enregistrement de l'événement key, accepté pendant la frame en cours
+ */
+void trace_put(uchar key) {
+    unsigned int delta = trace_frames - trace_at;
+    uchar k;
+
+    trace_at = trace_frames;
+    for(; delta > TRACE_DELTA_MAX; delta -= TRACE_DELTA_MAX) {
+        trace_store(TRACE_DELTA_MAX << 3);
+    }
+    for(k = 1; k < sizeof(trace_keys) && trace_keys[k] != key; k++) ;
+    trace_store((uchar) (delta << 3) | k);
+}
+
+/**
+ * trace_get(wait): événement suivant de la trace, s'il a été accepté pendant la frame en cours,
+ * sinon NO_KEY; avec wait (input_wait()), l'événement suivant quelle que soit sa frame. En fin de
+ * trace: KEY_ESC (fin de la partie)
+ */
+uchar trace_get(bool wait) {
+    uchar code;
+
+    for(; trace_pos < trace_length; trace_pos++) {
+        code = trace_data[trace_pos];
+        if(!wait && trace_at + (code >> 3) > trace_frames) return NO_KEY;
+        trace_at += code >> 3;
+        if((code & 7) != 0) {
+            trace_pos++;
+            return trace_keys[code & 7];
+        }
+    }
+    return KEY_ESC;
+}
+
+#endif /* INPUT_TRACE */